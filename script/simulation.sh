@@ -5,7 +5,7 @@ cd "$(dirname "$0")/.."
 interrupted=false
 trap interrupted=true SIGINT
 
-memory_create_command="./build/app/memory --create"
+memory_create_command="./build/app/memory --create --lock-free"
 memory_remove_command="./build/app/memory --remove"
 
 simulator_command="./build/app/simulator"
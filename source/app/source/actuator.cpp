@@ -1,4 +1,7 @@
+#include <cstdint>
+
 #include <string>
+#include <vector>
 
 #include <sys/logging.hpp>
 #include <sys/interrupt.hpp>
@@ -11,9 +14,14 @@
 #include <dev/servo.hpp>
 
 namespace logging::local {
-    std::string path = "log/system.log";
+    std::string path = "log/system.bin";
     std::string app = "actuator";
     std::string lib = "main";
+    logging::mode mode = logging::mode::split;
+
+    std::string levs_name = "log_levels", rate_name = "log_rate_limit", ratio_name = "log_sample_ratio";
+    std::vector<std::string> levs;
+    int rate, ratio;
 }
 
 namespace timing::local {
@@ -26,8 +34,14 @@ namespace config::local {
 }
 
 namespace channel::local {
+    std::string wait_name = "wait_update";
+    bool wait;
+
     bool acces = false, error;
     double ctrl;
+    channel::instance::stamp ctrl_stmp;
+    std::uint32_t ctrl_seq;
+    bool ctrl_read = false;
 }
 
 namespace i2c::local {
@@ -35,8 +49,12 @@ namespace i2c::local {
     std::string path;
 }
 
+namespace local {
+    class except {};
+}
+
 int main (void) {
-    if (!logging::instance::start(logging::local::path, logging::local::app)) {
+    if (!logging::instance::start(logging::local::path, logging::local::app, logging::local::mode)) {
         return 1;
     }
 
@@ -46,8 +64,25 @@ int main (void) {
     try {
         config::instance config(config::local::path);
 
+        logging::local::levs = config.get<std::vector<std::string>>(logging::local::levs_name);
+
+        if (!logging::instance::filter(logging::local::levs)) {
+            logging.err("Log levels must be of the form library:level");
+            throw local::except{};
+        }
+
+        logging::local::rate = config.get<int>(logging::local::rate_name);
+        logging::local::ratio = config.get<int>(logging::local::ratio_name);
+
+        if (!logging::instance::limit(logging::local::rate, logging::local::ratio)) {
+            logging.err("Log rate limit must be non-negative and log sample ratio must be positive");
+            throw local::except{};
+        }
+
         timing::local::dur = config.get<double>(timing::local::dur_name);
 
+        channel::local::wait = config.get<bool>(channel::local::wait_name);
+
         i2c::local::path = config.get<std::string>(i2c::local::path_name);
 
         interrupt::instance interrupt;
@@ -59,13 +94,26 @@ int main (void) {
         servo::instance servo(i2c);
 
         while (!interrupt.caught()) {
-            timing.sleep(timing::local::dur);
-
             channel::local::error = false;
 
+            if (channel::local::wait) {
+                try {
+                    channel.wait_ctrl(timing::local::dur);
+                } catch (channel::instance::except_wait_ctrl err) {
+                    if (err == channel::instance::except_wait_ctrl::timeout) {
+                        continue;
+                    }
+
+                    channel::local::error = true;
+                    timing.sleep(timing::local::dur);
+                }
+            } else {
+                timing.sleep(timing::local::dur);
+            }
+
             try {
                 if (!channel::local::acces) {
-                    channel.acquire();
+                    channel.acquire(channel::role::reader);
                     channel::local::acces = true;
                 }
             } catch (...) {
@@ -74,7 +122,7 @@ int main (void) {
 
             try {
                 if (channel::local::acces) {
-                    channel::local::ctrl = channel.get_ctrl();
+                    channel::local::ctrl = channel.get_ctrl(channel::local::ctrl_stmp);
                 }
             } catch (...) {
                 channel::local::error = true;
@@ -93,8 +141,21 @@ int main (void) {
                 continue;
             }
 
+            if (channel::local::ctrl_read && channel::local::ctrl_stmp.seq == channel::local::ctrl_seq) {
+                continue;
+            }
+
+            channel::local::ctrl_read = true;
+            channel::local::ctrl_seq = channel::local::ctrl_stmp.seq;
+
             try {
                 servo.put_pos(channel::local::ctrl);
+            } catch (...) {
+                continue;
+            }
+
+            try {
+                logging.inf("Actuated control signal: Latency: ", timing.get_time() - channel::local::ctrl_stmp.orig);
             } catch (...) {}
         }
     } catch (...) {
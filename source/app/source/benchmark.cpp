@@ -0,0 +1,387 @@
+#include <cmath>
+#include <cstdint>
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <csignal>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include <math/linalg.hpp>
+
+#include <sys/logging.hpp>
+#include <sys/interrupt.hpp>
+#include <sys/timing.hpp>
+#include <sys/config.hpp>
+
+#include <ipc/sharedmem.hpp>
+#include <ipc/channel.hpp>
+
+namespace logging::local {
+    std::string path = "log/system.bin";
+    std::string app = "benchmark";
+    std::string lib = "main";
+    logging::mode mode = logging::mode::split;
+
+    std::string levs_name = "log_levels", rate_name = "log_rate_limit", ratio_name = "log_sample_ratio";
+    std::vector<std::string> levs;
+    int rate, ratio;
+}
+
+namespace timing::local {
+    std::string dur_name = "sleep_duration", start_name = "start_delay";
+    double dur, start;
+}
+
+namespace config::local {
+    std::string path = "config/benchmark.conf";
+}
+
+namespace channel::local {
+    std::string name = "benchmark_channel", acces = "benchmark_acces";
+    std::string sync_name = "synchronization", wait_name = "wait_timeout", sens_name = "sensing_vector";
+    std::string sync_lock_name = "lock", sync_free_name = "lock-free", sync_prio_name = "priority-lock";
+    std::string sync_str;
+    channel::sync sync;
+    double wait;
+
+    linalg::fvector sens;
+    channel::instance::stamp stmp;
+    std::uint32_t last;
+}
+
+namespace sharedmem::local {
+    std::string name = "benchmark_";
+}
+
+namespace local {
+    std::string cons_name = "consumer_count", count_name = "sample_count";
+    int cons, count;
+
+    const int limit = 50000;
+
+    struct result {
+        int count, lost;
+        double strt, stop;
+        double late[limit], wait[limit], hold[limit];
+    };
+
+    result res;
+    std::vector<result> cons_res;
+    result prod_res;
+
+    pid_t prod_pid;
+    std::vector<pid_t> cons_pid;
+
+    class except {};
+}
+
+int main (void) {
+    if (!logging::instance::start(logging::local::path, logging::local::app, logging::local::mode)) {
+        return 1;
+    }
+
+    logging::instance logging(logging::local::lib);
+    logging.inf("Starting");
+
+    try {
+        config::instance config(config::local::path);
+
+        logging::local::levs = config.get<std::vector<std::string>>(logging::local::levs_name);
+
+        if (!logging::instance::filter(logging::local::levs)) {
+            logging.err("Log levels must be of the form library:level");
+            throw local::except{};
+        }
+
+        logging::local::rate = config.get<int>(logging::local::rate_name);
+        logging::local::ratio = config.get<int>(logging::local::ratio_name);
+
+        if (!logging::instance::limit(logging::local::rate, logging::local::ratio)) {
+            logging.err("Log rate limit must be non-negative and log sample ratio must be positive");
+            throw local::except{};
+        }
+
+        timing::local::dur = config.get<double>(timing::local::dur_name);
+        timing::local::start = config.get<double>(timing::local::start_name);
+
+        channel::local::sync_str = config.get<std::string>(channel::local::sync_name);
+        channel::local::wait = config.get<double>(channel::local::wait_name);
+        channel::local::sens = config.get<linalg::fvector>(channel::local::sens_name);
+
+        local::cons = config.get<int>(local::cons_name);
+        local::count = config.get<int>(local::count_name);
+
+        if (timing::local::dur < 0) {
+            logging.err("Sleep duration must be non-negative");
+            throw local::except{};
+        }
+
+        if (timing::local::start < 0) {
+            logging.err("Start delay must be non-negative");
+            throw local::except{};
+        }
+
+        if (channel::local::sync_str == channel::local::sync_lock_name) {
+            channel::local::sync = channel::sync::lock;
+        } else if (channel::local::sync_str == channel::local::sync_free_name) {
+            channel::local::sync = channel::sync::free;
+        } else if (channel::local::sync_str == channel::local::sync_prio_name) {
+            channel::local::sync = channel::sync::prio;
+        } else {
+            logging.err("Synchronization must be one of lock, lock-free or priority-lock");
+            throw local::except{};
+        }
+
+        if (channel::local::wait <= 0) {
+            logging.err("Wait timeout must be positive");
+            throw local::except{};
+        }
+
+        if (local::cons <= 0) {
+            logging.err("Consumer count must be positive");
+            throw local::except{};
+        }
+
+        if (local::count <= 0 || local::count > local::limit) {
+            logging.err("Sample count must be positive and at most ", local::limit);
+            throw local::except{};
+        }
+
+        interrupt::instance interrupt;
+        timing::instance timing;
+
+        channel::instance channel(channel::local::name, channel::local::acces, channel::mode::both);
+
+        channel.acquire(channel::role::writer);
+        channel.clear();
+        channel.set_sync(channel::local::sync);
+        channel.release();
+
+        std::vector<std::unique_ptr<sharedmem::instance<local::result>>> memory;
+        for (int i = 0; i <= local::cons; i++) {
+            memory.push_back(
+                std::make_unique<sharedmem::instance<local::result>>(sharedmem::local::name + std::to_string(i), sharedmem::mode::both)
+            );
+        }
+
+        for (int i = 1; i <= local::cons; i++) {
+            pid_t pid = fork();
+
+            if (pid < 0) {
+                logging.err("Failed to spawn consumer #", i);
+                for (auto pid : local::cons_pid) {
+                    kill(pid, SIGINT);
+                    waitpid(pid, nullptr, 0);
+                }
+                throw local::except{};
+            }
+
+            if (pid == 0) {
+                int code = 0;
+
+                local::res.count = 0;
+                local::res.lost = 0;
+
+                try {
+                    while (!interrupt.caught() && local::res.count < local::limit) {
+                        try {
+                            channel.wait_sens(channel::local::wait);
+                        } catch (channel::instance::except_wait_sens err) {
+                            if (err == channel::instance::except_wait_sens::timeout && local::res.count == 0) {
+                                continue;
+                            }
+                            break;
+                        }
+
+                        double time_wait = timing.get_time();
+                        channel.acquire(channel::role::reader);
+                        double time_hold = timing.get_time();
+                        try {
+                            channel.get_sens(channel::local::stmp);
+                        } catch (channel::instance::except_get_sens err) {
+                            channel.release();
+                            if (err == channel::instance::except_get_sens::blank) {
+                                continue;
+                            }
+                            throw;
+                        }
+                        double time_seen = timing.get_time();
+                        channel.release();
+                        double time_done = timing.get_time();
+
+                        if (local::res.count == 0) {
+                            local::res.strt = time_seen;
+                        } else {
+                            local::res.lost += channel::local::stmp.seq - channel::local::last - 1;
+                        }
+                        local::res.stop = time_seen;
+
+                        local::res.late[local::res.count] = time_seen - channel::local::stmp.time;
+                        local::res.wait[local::res.count] = time_hold - time_wait;
+                        local::res.hold[local::res.count] = time_done - time_hold;
+                        local::res.count++;
+
+                        channel::local::last = channel::local::stmp.seq;
+                    }
+
+                    memory[i]->put(local::res);
+                } catch (...) {
+                    logging.err("Consumer #", i, " failed");
+                    code = 1;
+                }
+
+                logging::instance::stop();
+                _exit(code);
+            }
+
+            local::cons_pid.push_back(pid);
+        }
+
+        timing.sleep(timing::local::start);
+
+        local::prod_pid = fork();
+
+        if (local::prod_pid < 0) {
+            logging.err("Failed to spawn producer");
+            for (auto pid : local::cons_pid) {
+                kill(pid, SIGINT);
+                waitpid(pid, nullptr, 0);
+            }
+            throw local::except{};
+        }
+
+        if (local::prod_pid == 0) {
+            int code = 0;
+
+            local::res.count = 0;
+            local::res.lost = 0;
+
+            try {
+                local::res.strt = timing.get_time();
+
+                while (!interrupt.caught() && local::res.count < local::count) {
+                    double time_wait = timing.get_time();
+                    channel.acquire(channel::role::writer);
+                    double time_hold = timing.get_time();
+                    channel.put_sens(channel::local::sens);
+                    double time_sent = timing.get_time();
+                    channel.release();
+                    double time_done = timing.get_time();
+
+                    local::res.late[local::res.count] = time_sent - time_hold;
+                    local::res.wait[local::res.count] = time_hold - time_wait;
+                    local::res.hold[local::res.count] = time_done - time_hold;
+                    local::res.count++;
+
+                    if (timing::local::dur > 0) {
+                        timing.sleep(timing::local::dur);
+                    }
+                }
+
+                local::res.stop = timing.get_time();
+
+                memory[0]->put(local::res);
+            } catch (...) {
+                logging.err("Producer failed");
+                code = 1;
+            }
+
+            logging::instance::stop();
+            _exit(code);
+        }
+
+        bool fail = false;
+        int stat;
+
+        waitpid(local::prod_pid, &stat, 0);
+        if (!WIFEXITED(stat) || WEXITSTATUS(stat) != 0) {
+            logging.err("Producer exited abnormally");
+            for (auto pid : local::cons_pid) {
+                kill(pid, SIGINT);
+            }
+            fail = true;
+        }
+
+        for (int i = 1; i <= local::cons; i++) {
+            waitpid(local::cons_pid[i - 1], &stat, 0);
+            if (!WIFEXITED(stat) || WEXITSTATUS(stat) != 0) {
+                logging.err("Consumer #", i, " exited abnormally");
+                fail = true;
+            }
+        }
+
+        if (fail) {
+            throw local::except{};
+        }
+
+        local::prod_res = memory[0]->get();
+        for (int i = 1; i <= local::cons; i++) {
+            local::cons_res.push_back(memory[i]->get());
+        }
+
+        auto stats = [] (const std::string & label, const double * data, int count) {
+            std::vector<double> vals(data, data + count);
+            std::sort(vals.begin(), vals.end());
+
+            auto pctl = [&vals] (double frac) {
+                int idx = std::max(0, int(std::ceil(frac * vals.size())) - 1);
+                return vals[idx] * 1e6;
+            };
+
+            std::cout << "    " << std::left << std::setw(14) << label << std::right << std::fixed << std::setprecision(1);
+            if (vals.empty()) {
+                std::cout << " (no samples)" << std::endl;
+                return;
+            }
+            std::cout << " p50 " << std::setw(9) << pctl(0.5)
+                      << " us  p99 " << std::setw(9) << pctl(0.99)
+                      << " us  p99.9 " << std::setw(9) << pctl(0.999)
+                      << " us  max " << std::setw(9) << vals.back() * 1e6 << " us" << std::endl;
+        };
+
+        auto rate = [] (const local::result & res) {
+            return (res.count > 1 && res.stop > res.strt) ? (res.count - 1) / (res.stop - res.strt) : 0.0;
+        };
+
+        std::cout << "Synchronization: " << channel::local::sync_str
+                  << ", Consumers: " << local::cons << ", Samples: " << local::count
+                  << ", Sleep duration: " << timing::local::dur << " s" << std::endl;
+
+        std::cout << "Producer: Published: " << local::prod_res.count
+                  << ", Throughput: " << std::fixed << std::setprecision(1) << rate(local::prod_res) << " /s" << std::endl;
+        stats("Put", local::prod_res.late, local::prod_res.count);
+        stats("Acquire wait", local::prod_res.wait, local::prod_res.count);
+        stats("Lock hold", local::prod_res.hold, local::prod_res.count);
+
+        std::vector<double> late;
+        for (int i = 1; i <= local::cons; i++) {
+            auto & res = local::cons_res[i - 1];
+
+            std::cout << "Consumer #" << i << ": Observed: " << res.count << ", Lost: " << res.lost
+                      << ", Throughput: " << std::fixed << std::setprecision(1) << rate(res) << " /s" << std::endl;
+            stats("Latency", res.late, res.count);
+            stats("Acquire wait", res.wait, res.count);
+            stats("Lock hold", res.hold, res.count);
+
+            late.insert(late.end(), res.late, res.late + res.count);
+        }
+
+        std::cout << "All consumers:" << std::endl;
+        stats("Latency", late.data(), late.size());
+    } catch (...) {
+        logging.wrn("Exiting");
+        logging::instance::stop();
+        return 1;
+    }
+
+    logging.inf("Exiting");
+    logging::instance::stop();
+
+    return 0;
+}
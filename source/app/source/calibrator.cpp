@@ -1,4 +1,5 @@
 #include <string>
+#include <vector>
 
 #include <math/linalg.hpp>
 
@@ -19,9 +20,13 @@
 #include <dev/bno055.hpp>
 
 namespace logging::local {
-    std::string path = "log/system.log";
+    std::string path = "log/system.bin";
     std::string app = "calibrator";
     std::string lib = "main";
+
+    std::string levs_name = "log_levels", rate_name = "log_rate_limit", ratio_name = "log_sample_ratio";
+    std::vector<std::string> levs;
+    int rate, ratio;
 }
 
 namespace timing::local {
@@ -63,6 +68,10 @@ namespace bno055::local {
     bool valid_off_acc2, valid_off_mag2, valid_off_gyr2;
 }
 
+namespace local {
+    class except {};
+}
+
 int main (void) {
     if (!logging::instance::start(logging::local::path, logging::local::app)) {
         return 1;
@@ -74,6 +83,21 @@ int main (void) {
     try {
         config::instance config(config::local::path);
 
+        logging::local::levs = config.get<std::vector<std::string>>(logging::local::levs_name);
+
+        if (!logging::instance::filter(logging::local::levs)) {
+            logging.err("Log levels must be of the form library:level");
+            throw local::except{};
+        }
+
+        logging::local::rate = config.get<int>(logging::local::rate_name);
+        logging::local::ratio = config.get<int>(logging::local::ratio_name);
+
+        if (!logging::instance::limit(logging::local::rate, logging::local::ratio)) {
+            logging.err("Log rate limit must be non-negative and log sample ratio must be positive");
+            throw local::except{};
+        }
+
         timing::local::dur = config.get<double>(timing::local::dur_name);
 
         i2c::local::path = config.get<std::string>(i2c::local::path_name);
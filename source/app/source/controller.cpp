@@ -1,4 +1,7 @@
+#include <cstdint>
+
 #include <string>
+#include <vector>
 
 #include <math/linalg.hpp>
 
@@ -12,9 +15,14 @@
 #include <dyn/cntrl.hpp>
 
 namespace logging::local {
-    std::string path = "log/system.log";
+    std::string path = "log/system.bin";
     std::string app = "controller";
     std::string lib = "main";
+    logging::mode mode = logging::mode::split;
+
+    std::string levs_name = "log_levels", rate_name = "log_rate_limit", ratio_name = "log_sample_ratio";
+    std::vector<std::string> levs;
+    int rate, ratio;
 }
 
 namespace timing::local {
@@ -27,9 +35,15 @@ namespace config::local {
 }
 
 namespace channel::local {
+    std::string wait_name = "wait_update";
+    bool wait;
+
     bool acces = false, error;
     double ctrl;
     linalg::fvector estm;
+    channel::instance::stamp estm_stmp;
+    std::uint32_t estm_seq;
+    bool estm_read = false;
 }
 
 namespace cntrl::local {
@@ -48,16 +62,37 @@ namespace cntrl::local {
                 mpc_step_name = "time_step",
                 mpc_phrz_name = "prediction_horizon",
                 mpc_thrz_name = "termination_horizon",
-                mpc_tol_name = "tolerance";
+                mpc_tol_name = "tolerance",
+                mpc_wrkr_name = "worker_count",
+                mpc_btch_name = "batch_size",
+                mpc_warm_name = "warm_start",
+                mpc_adap_name = "adaptive_step",
+                mpc_atol_name = "adaptive_tolerance",
+                mpc_dead_name = "compute_deadline",
+                mpc_budg_name = "compute_budget";
+
+    std::string srf_used_name = "surface_lookup",
+                srf_fall_name = "surface_fallback";
 
     std::string aer_path = "input/aerodynamic-data.csv", atm_path = "input/atmospheric-data.csv";
+    std::string srf_path = "input/apogee-surface.dat";
     double env_grvty, env_gcnst, env_molar, env_gamma;
     double vhc_mass, vhc_iner, vhc_cmas, vhc_area;
     double mpc_apog, mpc_enab, mpc_step, mpc_phrz, mpc_thrz, mpc_tol;
+    int mpc_wrkr, mpc_btch;
+    bool mpc_warm, mpc_adap;
+    double mpc_atol;
+    bool mpc_dead;
+    double mpc_budg;
+    bool srf_used, srf_fall;
+}
+
+namespace local {
+    class except {};
 }
 
 int main (void) {
-    if (!logging::instance::start(logging::local::path, logging::local::app)) {
+    if (!logging::instance::start(logging::local::path, logging::local::app, logging::local::mode)) {
         return 1;
     }
 
@@ -67,8 +102,25 @@ int main (void) {
     try {
         config::instance config(config::local::path);
 
+        logging::local::levs = config.get<std::vector<std::string>>(logging::local::levs_name);
+
+        if (!logging::instance::filter(logging::local::levs)) {
+            logging.err("Log levels must be of the form library:level");
+            throw local::except{};
+        }
+
+        logging::local::rate = config.get<int>(logging::local::rate_name);
+        logging::local::ratio = config.get<int>(logging::local::ratio_name);
+
+        if (!logging::instance::limit(logging::local::rate, logging::local::ratio)) {
+            logging.err("Log rate limit must be non-negative and log sample ratio must be positive");
+            throw local::except{};
+        }
+
         timing::local::dur = config.get<double>(timing::local::dur_name);
 
+        channel::local::wait = config.get<bool>(channel::local::wait_name);
+
         cntrl::local::env_grvty = config.get<double>(cntrl::local::env_grvty_name);
         cntrl::local::env_gcnst = config.get<double>(cntrl::local::env_gcnst_name);
         cntrl::local::env_molar = config.get<double>(cntrl::local::env_molar_name);
@@ -85,6 +137,16 @@ int main (void) {
         cntrl::local::mpc_phrz = config.get<double>(cntrl::local::mpc_phrz_name);
         cntrl::local::mpc_thrz = config.get<double>(cntrl::local::mpc_thrz_name);
         cntrl::local::mpc_tol = config.get<double>(cntrl::local::mpc_tol_name);
+        cntrl::local::mpc_wrkr = config.get<int>(cntrl::local::mpc_wrkr_name);
+        cntrl::local::mpc_btch = config.get<int>(cntrl::local::mpc_btch_name);
+        cntrl::local::mpc_warm = config.get<bool>(cntrl::local::mpc_warm_name);
+        cntrl::local::mpc_adap = config.get<bool>(cntrl::local::mpc_adap_name);
+        cntrl::local::mpc_atol = config.get<double>(cntrl::local::mpc_atol_name);
+        cntrl::local::mpc_dead = config.get<bool>(cntrl::local::mpc_dead_name);
+        cntrl::local::mpc_budg = config.get<double>(cntrl::local::mpc_budg_name);
+
+        cntrl::local::srf_used = config.get<bool>(cntrl::local::srf_used_name);
+        cntrl::local::srf_fall = config.get<bool>(cntrl::local::srf_fall_name);
 
         interrupt::instance interrupt;
         timing::instance timing;
@@ -92,21 +154,37 @@ int main (void) {
         channel::instance channel(channel::mode::none);
 
         cntrl::instance cntrl(
-                            cntrl::local::aer_path, cntrl::local::atm_path,
+                            cntrl::local::aer_path, cntrl::local::atm_path, cntrl::local::srf_path,
                             cntrl::local::env_grvty, cntrl::local::env_gcnst, cntrl::local::env_molar, cntrl::local::env_gamma,
                             cntrl::local::vhc_mass, cntrl::local::vhc_iner, cntrl::local::vhc_cmas, cntrl::local::vhc_area,
                             cntrl::local::mpc_apog, cntrl::local::mpc_enab,
-                            cntrl::local::mpc_step, cntrl::local::mpc_phrz, cntrl::local::mpc_thrz, cntrl::local::mpc_tol
+                            cntrl::local::mpc_step, cntrl::local::mpc_phrz, cntrl::local::mpc_thrz, cntrl::local::mpc_tol,
+                            cntrl::local::mpc_wrkr, cntrl::local::mpc_btch, cntrl::local::mpc_warm, cntrl::local::mpc_adap, cntrl::local::mpc_atol,
+                            cntrl::local::mpc_dead, cntrl::local::mpc_budg,
+                            cntrl::local::srf_used, cntrl::local::srf_fall
                         );
 
         while (!interrupt.caught()) {
-            timing.sleep(timing::local::dur);
-
             channel::local::error = false;
 
+            if (channel::local::wait) {
+                try {
+                    channel.wait_estm(timing::local::dur);
+                } catch (channel::instance::except_wait_estm err) {
+                    if (err == channel::instance::except_wait_estm::timeout) {
+                        continue;
+                    }
+
+                    channel::local::error = true;
+                    timing.sleep(timing::local::dur);
+                }
+            } else {
+                timing.sleep(timing::local::dur);
+            }
+
             try {
                 if (!channel::local::acces) {
-                    channel.acquire();
+                    channel.acquire(channel::role::reader);
                     channel::local::acces = true;
                 }
             } catch (...) {
@@ -115,7 +193,7 @@ int main (void) {
 
             try {
                 if (channel::local::acces) {
-                    channel::local::estm = channel.get_estm();
+                    channel::local::estm = channel.get_estm(channel::local::estm_stmp);
                 }
             } catch (...) {
                 channel::local::error = true;
@@ -134,6 +212,13 @@ int main (void) {
                 continue;
             }
 
+            if (channel::local::estm_read && channel::local::estm_stmp.seq == channel::local::estm_seq) {
+                continue;
+            }
+
+            channel::local::estm_read = true;
+            channel::local::estm_seq = channel::local::estm_stmp.seq;
+
             try {
                 channel::local::ctrl = cntrl.get_ctrl(channel::local::estm);
             } catch (...) {
@@ -142,14 +227,14 @@ int main (void) {
 
             try {
                 if (!channel::local::acces) {
-                    channel.acquire();
+                    channel.acquire(channel::role::writer);
                     channel::local::acces = true;
                 }
             } catch (...) {}
 
             try {
                 if (channel::local::acces) {
-                    channel.put_ctrl(channel::local::ctrl);
+                    channel.put_ctrl(channel::local::ctrl, channel::local::estm_stmp.orig);
                 }
             } catch (...) {}
 
@@ -16,7 +16,7 @@
 #include <ipc/channel.hpp>
 
 namespace logging::local {
-    std::string path = "log/system.log";
+    std::string path = "log/system.bin";
     std::string app = "dashboard";
     std::string lib = "main";
 }
@@ -174,7 +174,7 @@ int main (int argc, char ** argv) {
 
             try {
                 if (!channel::local::acces) {
-                    channel.acquire();
+                    channel.acquire(channel::role::reader);
                     channel::local::acces = true;
                 }
             } catch (...) {
@@ -352,7 +352,7 @@ int main (int argc, char ** argv) {
 
             try {
                 if (!channel::local::acces) {
-                    channel.acquire();
+                    channel.acquire(channel::role::writer);
                     channel::local::acces = true;
                 }
             } catch (...) {
@@ -0,0 +1,119 @@
+#include <cstdint>
+
+#include <algorithm>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <sys/logging.hpp>
+
+#include <dat/logread.hpp>
+#include <dat/txtwrite.hpp>
+
+namespace logging::local {
+    std::string path = "log/decoder.bin";
+    std::string app = "decoder";
+    std::string lib = "main";
+
+    std::vector<std::string> levs = {"*:wrn"};
+}
+
+namespace logread::local {
+    std::string dir = "log", stem = "system", ext = ".bin";
+    std::vector<std::string> paths;
+}
+
+namespace txtwrite::local {
+    std::string path = "log/system.log";
+}
+
+namespace local {
+    std::string line;
+    std::int64_t time, stmp;
+    int next;
+
+    class except {};
+}
+
+int main (void) {
+    if (!logging::instance::start(logging::local::path, logging::local::app)) {
+        return 1;
+    }
+
+    logging::instance logging(logging::local::lib);
+    logging.inf("Starting");
+
+    try {
+        logging::instance::filter(logging::local::levs);
+
+        try {
+            for (const auto & elem : std::filesystem::directory_iterator(logread::local::dir)) {
+                std::string name = elem.path().filename().string();
+
+                if (name.rfind(logread::local::stem + ".", 0) == 0
+                        && name.size() >= logread::local::ext.size()
+                        && name.compare(name.size() - logread::local::ext.size(), logread::local::ext.size(), logread::local::ext) == 0) {
+                    logread::local::paths.push_back(elem.path().string());
+                }
+            }
+        } catch (const std::filesystem::filesystem_error &) {
+            logging.err("Failed to list log directory");
+            throw local::except{};
+        }
+
+        if (logread::local::paths.empty()) {
+            logging.err("No log files found");
+            throw local::except{};
+        }
+
+        std::sort(logread::local::paths.begin(), logread::local::paths.end());
+
+        std::vector<std::unique_ptr<logread::instance>> logread;
+        for (const auto & path : logread::local::paths) {
+            logread.push_back(std::make_unique<logread::instance>(path));
+        }
+
+        txtwrite::instance txtwrite(txtwrite::local::path);
+
+        while (true) {
+            local::next = -1;
+
+            for (int i = 0; i < int(logread.size());) {
+                try {
+                    local::stmp = logread[i]->get_time();
+                } catch (logread::instance::except_get_time err) {
+                    if (err != logread::instance::except_get_time::eof) {
+                        throw;
+                    }
+                    logread.erase(logread.begin() + i);
+                    continue;
+                }
+
+                if (local::next < 0 || local::stmp < local::time) {
+                    local::next = i;
+                    local::time = local::stmp;
+                }
+                i++;
+            }
+
+            if (local::next < 0) {
+                break;
+            }
+
+            local::line = logread[local::next]->get_line();
+
+            txtwrite.put(local::line.c_str());
+            txtwrite.newline();
+        }
+    } catch (...) {
+        logging.wrn("Exiting");
+        logging::instance::stop();
+        return 1;
+    }
+
+    logging.inf("Exiting");
+    logging::instance::stop();
+
+    return 0;
+}
@@ -12,9 +12,14 @@
 #include <ipc/channel.hpp>
 
 namespace logging::local {
-    std::string path = "log/system.log";
+    std::string path = "log/system.bin";
     std::string app = "detector";
     std::string lib = "main";
+    logging::mode mode = logging::mode::split;
+
+    std::string levs_name = "log_levels", rate_name = "log_rate_limit", ratio_name = "log_sample_ratio";
+    std::vector<std::string> levs;
+    int rate, ratio;
 }
 
 namespace timing::local {
@@ -27,6 +32,9 @@ namespace config::local {
 }
 
 namespace channel::local {
+    std::string wait_name = "wait_update";
+    bool wait;
+
     bool acces = false, error;
     linalg::fvector estm;
 }
@@ -41,7 +49,7 @@ namespace local {
 }
 
 int main (void) {
-    if (!logging::instance::start(logging::local::path, logging::local::app)) {
+    if (!logging::instance::start(logging::local::path, logging::local::app, logging::local::mode)) {
         return 1;
     }
 
@@ -51,8 +59,25 @@ int main (void) {
     try {
         config::instance config(config::local::path);
 
+        logging::local::levs = config.get<std::vector<std::string>>(logging::local::levs_name);
+
+        if (!logging::instance::filter(logging::local::levs)) {
+            logging.err("Log levels must be of the form library:level");
+            throw local::except{};
+        }
+
+        logging::local::rate = config.get<int>(logging::local::rate_name);
+        logging::local::ratio = config.get<int>(logging::local::ratio_name);
+
+        if (!logging::instance::limit(logging::local::rate, logging::local::ratio)) {
+            logging.err("Log rate limit must be non-negative and log sample ratio must be positive");
+            throw local::except{};
+        }
+
         timing::local::dur = config.get<double>(timing::local::dur_name);
 
+        channel::local::wait = config.get<bool>(channel::local::wait_name);
+
         local::enab = config.get<double>(local::enab_name);
         local::count = config.get<int>(local::count_name);
 
@@ -74,13 +99,26 @@ int main (void) {
         local::categ = std::vector<int>(local::count, 0);
 
         while (!interrupt.caught()) {
-            timing.sleep(timing::local::dur);
-
             channel::local::error = false;
 
+            if (channel::local::wait) {
+                try {
+                    channel.wait_estm(timing::local::dur);
+                } catch (channel::instance::except_wait_estm err) {
+                    if (err == channel::instance::except_wait_estm::timeout) {
+                        continue;
+                    }
+
+                    channel::local::error = true;
+                    timing.sleep(timing::local::dur);
+                }
+            } else {
+                timing.sleep(timing::local::dur);
+            }
+
             try {
                 if (!channel::local::acces) {
-                    channel.acquire();
+                    channel.acquire(channel::role::reader);
                     channel::local::acces = true;
                 }
             } catch (...) {
@@ -1,4 +1,7 @@
+#include <cstdint>
+
 #include <string>
+#include <vector>
 
 #include <math/linalg.hpp>
 
@@ -12,9 +15,14 @@
 #include <dyn/estim.hpp>
 
 namespace logging::local {
-    std::string path = "log/system.log";
+    std::string path = "log/system.bin";
     std::string app = "estimator";
     std::string lib = "main";
+    logging::mode mode = logging::mode::split;
+
+    std::string levs_name = "log_levels", rate_name = "log_rate_limit", ratio_name = "log_sample_ratio";
+    std::vector<std::string> levs;
+    int rate, ratio;
 }
 
 namespace timing::local {
@@ -27,8 +35,14 @@ namespace config::local {
 }
 
 namespace channel::local {
+    std::string wait_name = "wait_update";
+    bool wait;
+
     bool acces = false, error;
     linalg::fvector estm, sens;
+    channel::instance::stamp sens_stmp;
+    std::uint32_t sens_seq;
+    bool sens_read = false;
 }
 
 namespace estim::local {
@@ -40,8 +54,12 @@ namespace estim::local {
     double kalm_pos_var, kalm_acc_var;
 }
 
+namespace local {
+    class except {};
+}
+
 int main (void) {
-    if (!logging::instance::start(logging::local::path, logging::local::app)) {
+    if (!logging::instance::start(logging::local::path, logging::local::app, logging::local::mode)) {
         return 1;
     }
 
@@ -51,8 +69,25 @@ int main (void) {
     try {
         config::instance config(config::local::path);
 
+        logging::local::levs = config.get<std::vector<std::string>>(logging::local::levs_name);
+
+        if (!logging::instance::filter(logging::local::levs)) {
+            logging.err("Log levels must be of the form library:level");
+            throw local::except{};
+        }
+
+        logging::local::rate = config.get<int>(logging::local::rate_name);
+        logging::local::ratio = config.get<int>(logging::local::ratio_name);
+
+        if (!logging::instance::limit(logging::local::rate, logging::local::ratio)) {
+            logging.err("Log rate limit must be non-negative and log sample ratio must be positive");
+            throw local::except{};
+        }
+
         timing::local::dur = config.get<double>(timing::local::dur_name);
 
+        channel::local::wait = config.get<bool>(channel::local::wait_name);
+
         estim::local::regr_count = config.get<int>(estim::local::regr_count_name);
         estim::local::kalm_pos_var = config.get<double>(estim::local::kalm_pos_var_name);
         estim::local::kalm_acc_var = config.get<double>(estim::local::kalm_acc_var_name);
@@ -65,13 +100,26 @@ int main (void) {
         estim::instance estim(estim::local::atm_path, estim::local::regr_count, estim::local::kalm_pos_var, estim::local::kalm_acc_var);
 
         while (!interrupt.caught()) {
-            timing.sleep(timing::local::dur);
-
             channel::local::error = false;
 
+            if (channel::local::wait) {
+                try {
+                    channel.wait_sens(timing::local::dur);
+                } catch (channel::instance::except_wait_sens err) {
+                    if (err == channel::instance::except_wait_sens::timeout) {
+                        continue;
+                    }
+
+                    channel::local::error = true;
+                    timing.sleep(timing::local::dur);
+                }
+            } else {
+                timing.sleep(timing::local::dur);
+            }
+
             try {
                 if (!channel::local::acces) {
-                    channel.acquire();
+                    channel.acquire(channel::role::reader);
                     channel::local::acces = true;
                 }
             } catch (...) {
@@ -80,7 +128,7 @@ int main (void) {
 
             try {
                 if (channel::local::acces) {
-                    channel::local::sens = channel.get_sens();
+                    channel::local::sens = channel.get_sens(channel::local::sens_stmp);
                 }
             } catch (...) {
                 channel::local::error = true;
@@ -99,6 +147,13 @@ int main (void) {
                 continue;
             }
 
+            if (channel::local::sens_read && channel::local::sens_stmp.seq == channel::local::sens_seq) {
+                continue;
+            }
+
+            channel::local::sens_read = true;
+            channel::local::sens_seq = channel::local::sens_stmp.seq;
+
             try {
                 channel::local::estm = estim.get_estm(channel::local::sens);
             } catch (...) {
@@ -107,14 +162,14 @@ int main (void) {
 
             try {
                 if (!channel::local::acces) {
-                    channel.acquire();
+                    channel.acquire(channel::role::writer);
                     channel::local::acces = true;
                 }
             } catch (...) {}
 
             try {
                 if (channel::local::acces) {
-                    channel.put_estm(channel::local::estm);
+                    channel.put_estm(channel::local::estm, channel::local::sens_stmp.orig);
                 }
             } catch (...) {}
 
@@ -15,9 +15,14 @@
 #include <dev/bno055.hpp>
 
 namespace logging::local {
-    std::string path = "log/system.log";
+    std::string path = "log/system.bin";
     std::string app = "instrument";
     std::string lib = "main";
+    logging::mode mode = logging::mode::split;
+
+    std::string levs_name = "log_levels", rate_name = "log_rate_limit", ratio_name = "log_sample_ratio";
+    std::vector<std::string> levs;
+    int rate, ratio;
 }
 
 namespace timing::local {
@@ -66,8 +71,12 @@ namespace bno055::local {
     bool valid1, valid2, valid_mean = false;
 }
 
+namespace local {
+    class except {};
+}
+
 int main (void) {
-    if (!logging::instance::start(logging::local::path, logging::local::app)) {
+    if (!logging::instance::start(logging::local::path, logging::local::app, logging::local::mode)) {
         return 1;
     }
 
@@ -77,6 +86,21 @@ int main (void) {
     try {
         config::instance config(config::local::path);
 
+        logging::local::levs = config.get<std::vector<std::string>>(logging::local::levs_name);
+
+        if (!logging::instance::filter(logging::local::levs)) {
+            logging.err("Log levels must be of the form library:level");
+            throw local::except{};
+        }
+
+        logging::local::rate = config.get<int>(logging::local::rate_name);
+        logging::local::ratio = config.get<int>(logging::local::ratio_name);
+
+        if (!logging::instance::limit(logging::local::rate, logging::local::ratio)) {
+            logging.err("Log rate limit must be non-negative and log sample ratio must be positive");
+            throw local::except{};
+        }
+
         timing::local::dur = config.get<double>(timing::local::dur_name);
 
         i2c::local::path = config.get<std::string>(i2c::local::path_name);
@@ -218,7 +242,7 @@ int main (void) {
 
             try {
                 if (!channel::local::acces) {
-                    channel.acquire();
+                    channel.acquire(channel::role::writer);
                     channel::local::acces = true;
                 }
             } catch (...) {}
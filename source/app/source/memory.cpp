@@ -7,7 +7,7 @@
 #include <ipc/channel.hpp>
 
 namespace logging::local {
-    std::string path = "log/system.log";
+    std::string path = "log/system.bin";
     std::string app = "memory";
     std::string lib = "main";
 }
@@ -21,6 +21,9 @@ namespace channel::local {
     bool mode_create, mode_remove;
     int mode_count = 0;
     channel::mode mode;
+
+    std::string sync_free_name = "lock-free", sync_prio_name = "priority-lock";
+    bool sync_free, sync_prio;
 }
 
 namespace local {
@@ -36,11 +39,15 @@ int main (int argc, char ** argv) {
     logging.inf("Starting");
 
     try {
-        option::local::names = {channel::local::mode_create_name, channel::local::mode_remove_name};
+        option::local::names = {
+            channel::local::mode_create_name, channel::local::mode_remove_name, channel::local::sync_free_name, channel::local::sync_prio_name
+        };
         option::instance option(argc, argv, option::local::names);
 
         channel::local::mode_create = option.get(channel::local::mode_create_name);
         channel::local::mode_remove = option.get(channel::local::mode_remove_name);
+        channel::local::sync_free = option.get(channel::local::sync_free_name);
+        channel::local::sync_prio = option.get(channel::local::sync_prio_name);
 
         for (auto mode : {channel::local::mode_create, channel::local::mode_remove}) {
             if (mode) {
@@ -53,6 +60,21 @@ int main (int argc, char ** argv) {
             throw local::except{};
         }
 
+        if (channel::local::sync_free && !channel::local::mode_create) {
+            logging.err("Lock-free synchronization requires create mode");
+            throw local::except{};
+        }
+
+        if (channel::local::sync_prio && !channel::local::mode_create) {
+            logging.err("Priority lock synchronization requires create mode");
+            throw local::except{};
+        }
+
+        if (channel::local::sync_free && channel::local::sync_prio) {
+            logging.err("At most one synchronization must be selected");
+            throw local::except{};
+        }
+
         if (channel::local::mode_create) {
             channel::local::mode = channel::mode::create;
         }
@@ -63,8 +85,17 @@ int main (int argc, char ** argv) {
 
         channel::instance channel(channel::local::mode);
 
-        channel.acquire();
+        channel.acquire(channel::role::writer);
         channel.clear();
+        if (channel::local::mode_create) {
+            if (channel::local::sync_free) {
+                channel.set_sync(channel::sync::free);
+            } else if (channel::local::sync_prio) {
+                channel.set_sync(channel::sync::prio);
+            } else {
+                channel.set_sync(channel::sync::lock);
+            }
+        }
         channel.release();
     } catch (...) {
         logging.wrn("Exiting");
@@ -14,9 +14,14 @@
 #include <ipc/channel.hpp>
 
 namespace logging::local {
-    std::string path = "log/system.log";
+    std::string path = "log/system.bin";
     std::string app = "recorder";
     std::string lib = "main";
+    logging::mode mode = logging::mode::split;
+
+    std::string levs_name = "log_levels", rate_name = "log_rate_limit", ratio_name = "log_sample_ratio";
+    std::vector<std::string> levs;
+    int rate, ratio;
 }
 
 namespace timing::local {
@@ -33,9 +38,17 @@ namespace config::local {
 }
 
 namespace channel::local {
+    std::string wait_name = "wait_update", drain_name = "drain_history";
+    bool wait, drain;
+
     bool acces = false, error;
     double ctrl;
     linalg::fvector stat, estm, sens;
+    std::vector<double> ctrl_hist;
+    std::vector<linalg::fvector> stat_hist, estm_hist, sens_hist;
+    std::vector<channel::instance::stamp> stmp_hist;
+    bool drain_ctrl, drain_stat, drain_estm, drain_sens;
+    int count, lost;
 }
 
 namespace csvwrite::local {
@@ -53,7 +66,7 @@ namespace local {
 }
 
 int main (int argc, char ** argv) {
-    if (!logging::instance::start(logging::local::path, logging::local::app)) {
+    if (!logging::instance::start(logging::local::path, logging::local::app, logging::local::mode)) {
         return 1;
     }
 
@@ -82,8 +95,31 @@ int main (int argc, char ** argv) {
 
         config::instance config(config::local::path);
 
+        logging::local::levs = config.get<std::vector<std::string>>(logging::local::levs_name);
+
+        if (!logging::instance::filter(logging::local::levs)) {
+            logging.err("Log levels must be of the form library:level");
+            throw local::except{};
+        }
+
+        logging::local::rate = config.get<int>(logging::local::rate_name);
+        logging::local::ratio = config.get<int>(logging::local::ratio_name);
+
+        if (!logging::instance::limit(logging::local::rate, logging::local::ratio)) {
+            logging.err("Log rate limit must be non-negative and log sample ratio must be positive");
+            throw local::except{};
+        }
+
         timing::local::dur = config.get<double>(timing::local::dur_name);
 
+        channel::local::wait = config.get<bool>(channel::local::wait_name);
+        channel::local::drain = config.get<bool>(channel::local::drain_name);
+
+        channel::local::drain_sens = channel::local::drain && local::use_sens;
+        channel::local::drain_estm = channel::local::drain && local::use_estm && !local::use_sens;
+        channel::local::drain_ctrl = channel::local::drain && local::use_ctrl && !local::use_estm && !local::use_sens;
+        channel::local::drain_stat = channel::local::drain && local::use_stat && !local::use_ctrl && !local::use_estm && !local::use_sens;
+
         interrupt::instance interrupt;
         timing::instance timing;
 
@@ -137,13 +173,55 @@ int main (int argc, char ** argv) {
         csvwrite.put_head(csvwrite::local::head);
 
         while (!interrupt.caught()) {
-            timing.sleep(timing::local::dur);
-
             channel::local::error = false;
 
+            if (channel::local::wait) {
+                try {
+                    if (local::use_sens) {
+                        channel.wait_sens(timing::local::dur);
+                    } else if (local::use_estm) {
+                        channel.wait_estm(timing::local::dur);
+                    } else if (local::use_ctrl) {
+                        channel.wait_ctrl(timing::local::dur);
+                    } else {
+                        channel.wait_stat(timing::local::dur);
+                    }
+                } catch (channel::instance::except_wait_sens err) {
+                    if (err == channel::instance::except_wait_sens::timeout) {
+                        continue;
+                    }
+
+                    channel::local::error = true;
+                    timing.sleep(timing::local::dur);
+                } catch (channel::instance::except_wait_estm err) {
+                    if (err == channel::instance::except_wait_estm::timeout) {
+                        continue;
+                    }
+
+                    channel::local::error = true;
+                    timing.sleep(timing::local::dur);
+                } catch (channel::instance::except_wait_ctrl err) {
+                    if (err == channel::instance::except_wait_ctrl::timeout) {
+                        continue;
+                    }
+
+                    channel::local::error = true;
+                    timing.sleep(timing::local::dur);
+                } catch (channel::instance::except_wait_stat err) {
+                    if (err == channel::instance::except_wait_stat::timeout) {
+                        continue;
+                    }
+
+                    channel::local::error = true;
+                    timing.sleep(timing::local::dur);
+                }
+            } else {
+                timing.sleep(timing::local::dur);
+            }
+
             try {
                 if (!channel::local::acces) {
-                    channel.acquire();
+                    channel.acquire(channel::role::reader);
                     channel::local::acces = true;
                 }
             } catch (...) {
@@ -153,7 +231,7 @@ int main (int argc, char ** argv) {
             timing::local::time = timing.get_time();
 
             try {
-                if (channel::local::acces && local::use_ctrl) {
+                if (channel::local::acces && local::use_ctrl && !channel::local::drain_ctrl) {
                     channel::local::ctrl = channel.get_ctrl();
                 }
             } catch (...) {
@@ -161,7 +239,7 @@ int main (int argc, char ** argv) {
             }
 
             try {
-                if (channel::local::acces && local::use_stat) {
+                if (channel::local::acces && local::use_stat && !channel::local::drain_stat) {
                     channel::local::stat = channel.get_stat();
                 }
             } catch (...) {
@@ -169,7 +247,7 @@ int main (int argc, char ** argv) {
             }
 
             try {
-                if (channel::local::acces && local::use_estm) {
+                if (channel::local::acces && local::use_estm && !channel::local::drain_estm) {
                     channel::local::estm = channel.get_estm();
                 }
             } catch (...) {
@@ -177,13 +255,32 @@ int main (int argc, char ** argv) {
             }
 
             try {
-                if (channel::local::acces && local::use_sens) {
+                if (channel::local::acces && local::use_sens && !channel::local::drain_sens) {
                     channel::local::sens = channel.get_sens();
                 }
             } catch (...) {
                 channel::local::error = true;
             }
 
+            try {
+                if (channel::local::acces && !channel::local::error) {
+                    if (channel::local::drain_ctrl) {
+                        channel::local::ctrl_hist = channel.drain_ctrl(channel::local::lost, channel::local::stmp_hist);
+                    }
+                    if (channel::local::drain_stat) {
+                        channel::local::stat_hist = channel.drain_stat(channel::local::lost, channel::local::stmp_hist);
+                    }
+                    if (channel::local::drain_estm) {
+                        channel::local::estm_hist = channel.drain_estm(channel::local::lost, channel::local::stmp_hist);
+                    }
+                    if (channel::local::drain_sens) {
+                        channel::local::sens_hist = channel.drain_sens(channel::local::lost, channel::local::stmp_hist);
+                    }
+                }
+            } catch (...) {
+                channel::local::error = true;
+            }
+
             try {
                 if (channel::local::acces) {
                     channel.release();
@@ -197,28 +294,60 @@ int main (int argc, char ** argv) {
                 continue;
             }
 
-            csvwrite::local::body.clear();
-            csvwrite::local::body.push_back(timing::local::time);
-            if (local::use_ctrl) {
-                csvwrite::local::body.push_back(channel::local::ctrl);
+            channel::local::count = 1;
+            if (channel::local::drain_ctrl) {
+                channel::local::count = channel::local::ctrl_hist.size();
             }
-            if (local::use_stat) {
-                for (int i = 0; i < 7; i++) {
-                    csvwrite::local::body.push_back(channel::local::stat[i]);
-                }
+            if (channel::local::drain_stat) {
+                channel::local::count = channel::local::stat_hist.size();
             }
-            if (local::use_estm) {
-                for (int i = 0; i < 4; i++) {
-                    csvwrite::local::body.push_back(channel::local::estm[i]);
-                }
+            if (channel::local::drain_estm) {
+                channel::local::count = channel::local::estm_hist.size();
             }
-            if (local::use_sens) {
-                for (int i = 0; i < 17; i++) {
-                    csvwrite::local::body.push_back(channel::local::sens[i]);
-                }
+            if (channel::local::drain_sens) {
+                channel::local::count = channel::local::sens_hist.size();
             }
 
-            csvwrite.put_body(csvwrite::local::body);
+            for (int k = 0; k < channel::local::count; k++) {
+                if (channel::local::drain_ctrl) {
+                    channel::local::ctrl = channel::local::ctrl_hist[k];
+                }
+                if (channel::local::drain_stat) {
+                    channel::local::stat = channel::local::stat_hist[k];
+                }
+                if (channel::local::drain_estm) {
+                    channel::local::estm = channel::local::estm_hist[k];
+                }
+                if (channel::local::drain_sens) {
+                    channel::local::sens = channel::local::sens_hist[k];
+                }
+                if (channel::local::drain) {
+                    timing::local::time = channel::local::stmp_hist[k].time;
+                }
+
+                csvwrite::local::body.clear();
+                csvwrite::local::body.push_back(timing::local::time);
+                if (local::use_ctrl) {
+                    csvwrite::local::body.push_back(channel::local::ctrl);
+                }
+                if (local::use_stat) {
+                    for (int i = 0; i < 7; i++) {
+                        csvwrite::local::body.push_back(channel::local::stat[i]);
+                    }
+                }
+                if (local::use_estm) {
+                    for (int i = 0; i < 4; i++) {
+                        csvwrite::local::body.push_back(channel::local::estm[i]);
+                    }
+                }
+                if (local::use_sens) {
+                    for (int i = 0; i < 17; i++) {
+                        csvwrite::local::body.push_back(channel::local::sens[i]);
+                    }
+                }
+
+                csvwrite.put_body(csvwrite::local::body);
+            }
         }
     } catch (...) {
         logging.wrn("Exiting");
@@ -1,4 +1,5 @@
 #include <string>
+#include <vector>
 
 #include <math/linalg.hpp>
 
@@ -12,9 +13,13 @@
 #include <dyn/simul.hpp>
 
 namespace logging::local {
-    std::string path = "log/system.log";
+    std::string path = "log/system.bin";
     std::string app = "simulator";
     std::string lib = "main";
+
+    std::string levs_name = "log_levels", rate_name = "log_rate_limit", ratio_name = "log_sample_ratio";
+    std::vector<std::string> levs;
+    int rate, ratio;
 }
 
 namespace timing::local {
@@ -28,8 +33,7 @@ namespace config::local {
 
 namespace channel::local {
     bool acces = false;
-    double ctrl;
-    linalg::fvector stat, sens;
+    channel::instance::batch batch;
 }
 
 namespace simul::local {
@@ -75,6 +79,10 @@ namespace simul::local {
     linalg::fvector stat;
 }
 
+namespace local {
+    class except {};
+}
+
 int main (void) {
     if (!logging::instance::start(logging::local::path, logging::local::app)) {
         return 1;
@@ -86,6 +94,21 @@ int main (void) {
     try {
         config::instance config(config::local::path);
 
+        logging::local::levs = config.get<std::vector<std::string>>(logging::local::levs_name);
+
+        if (!logging::instance::filter(logging::local::levs)) {
+            logging.err("Log levels must be of the form library:level");
+            throw local::except{};
+        }
+
+        logging::local::rate = config.get<int>(logging::local::rate_name);
+        logging::local::ratio = config.get<int>(logging::local::ratio_name);
+
+        if (!logging::instance::limit(logging::local::rate, logging::local::ratio)) {
+            logging.err("Log rate limit must be non-negative and log sample ratio must be positive");
+            throw local::except{};
+        }
+
         timing::local::dur = config.get<double>(timing::local::dur_name);
 
         simul::local::env_grvty = config.get<double>(simul::local::env_grvty_name);
@@ -137,8 +160,10 @@ int main (void) {
         simul.put_ctrl(simul::local::ctrl);
         simul.put_stat(simul::local::stat);
 
-        channel::local::ctrl = simul::local::ctrl;
-        channel::local::stat = simul::local::stat;
+        channel::local::batch.stat_put = true;
+        channel::local::batch.sens_put = true;
+        channel::local::batch.ctrl_get = true;
+        channel::local::batch.ctrl = simul::local::ctrl;
 
         while (!interrupt.caught()) {
             timing.sleep(timing::local::dur);
@@ -148,21 +173,19 @@ int main (void) {
             simul.put_time(timing::local::time);
             simul.update();
 
-            channel::local::stat = simul.get_stat();
-            channel::local::sens = simul.get_sens();
+            channel::local::batch.stat = simul.get_stat();
+            channel::local::batch.sens = simul.get_sens();
 
             try {
                 if (!channel::local::acces) {
-                    channel.acquire();
+                    channel.acquire(channel::role::writer);
                     channel::local::acces = true;
                 }
             } catch (...) {}
 
             try {
                 if (channel::local::acces) {
-                    channel.put_stat(channel::local::stat);
-                    channel.put_sens(channel::local::sens);
-                    channel::local::ctrl = channel.get_ctrl();
+                    channel.transact(channel::local::batch);
                 }
             } catch (...) {}
 
@@ -173,7 +196,11 @@ int main (void) {
                 }
             } catch (...) {}
 
-            simul.put_ctrl(channel::local::ctrl);
+            if (channel::local::batch.ctrl_drdy) {
+                simul::local::ctrl = channel::local::batch.ctrl;
+            }
+
+            simul.put_ctrl(simul::local::ctrl);
         }
     } catch (...) {
         logging.wrn("Exiting");
@@ -0,0 +1,218 @@
+#include <string>
+#include <vector>
+
+#include <math/linalg.hpp>
+
+#include <sys/logging.hpp>
+#include <sys/interrupt.hpp>
+#include <sys/config.hpp>
+
+#include <dat/srfwrite.hpp>
+
+#include <dyn/cntrl.hpp>
+
+namespace logging::local {
+    std::string path = "log/system.bin";
+    std::string app = "tabulator";
+    std::string lib = "main";
+
+    std::string levs_name = "log_levels", rate_name = "log_rate_limit", ratio_name = "log_sample_ratio";
+    std::vector<std::string> levs;
+    int rate, ratio;
+}
+
+namespace config::local {
+    std::string path = "config/controller.conf";
+}
+
+namespace srfwrite::local {
+    std::string path = "input/apogee-surface.dat";
+    std::vector<double> lower, upper;
+    std::vector<int> count;
+    std::vector<double> body;
+}
+
+namespace cntrl::local {
+    std::string env_grvty_name = "gravitational_acceleration",
+                env_gcnst_name = "ideal_gas_constant",
+                env_molar_name = "molar_mass",
+                env_gamma_name = "gamma_factor";
+
+    std::string vhc_mass_name = "mass",
+                vhc_iner_name = "moment_of_inertia",
+                vhc_cmas_name = "center_of_mass",
+                vhc_area_name = "cross_sectional_area";
+
+    std::string mpc_apog_name = "apogee_altitude",
+                mpc_enab_name = "enable_altitude",
+                mpc_step_name = "time_step",
+                mpc_phrz_name = "prediction_horizon",
+                mpc_thrz_name = "termination_horizon",
+                mpc_tol_name = "tolerance",
+                mpc_adap_name = "adaptive_step",
+                mpc_atol_name = "adaptive_tolerance",
+                mpc_dead_name = "compute_deadline",
+                mpc_budg_name = "compute_budget";
+
+    std::vector<std::string> srf_range_names = {
+        "surface_altitude_range", "surface_angle_range", "surface_velocity_range", "surface_rate_range", "surface_attack_range",
+        "surface_brake_range"
+    };
+
+    std::vector<std::string> srf_points_names = {
+        "surface_altitude_points", "surface_angle_points", "surface_velocity_points", "surface_rate_points", "surface_attack_points",
+        "surface_brake_points"
+    };
+
+    std::string aer_path = "input/aerodynamic-data.csv", atm_path = "input/atmospheric-data.csv";
+    std::string srf_path = "input/apogee-surface.dat";
+    double env_grvty, env_gcnst, env_molar, env_gamma;
+    double vhc_mass, vhc_iner, vhc_cmas, vhc_area;
+    double mpc_apog, mpc_enab, mpc_step, mpc_phrz, mpc_thrz, mpc_tol;
+    bool mpc_adap;
+    double mpc_atol;
+    bool mpc_dead;
+    double mpc_budg;
+
+    linalg::fvector srf_range;
+    int srf_points;
+
+    linalg::fvector estm;
+    double attk, ctrl;
+}
+
+namespace local {
+    int size = 1;
+    std::vector<int> idx;
+
+    class except {};
+}
+
+int main (void) {
+    if (!logging::instance::start(logging::local::path, logging::local::app)) {
+        return 1;
+    }
+
+    logging::instance logging(logging::local::lib);
+    logging.inf("Starting");
+
+    try {
+        config::instance config(config::local::path);
+
+        logging::local::levs = config.get<std::vector<std::string>>(logging::local::levs_name);
+
+        if (!logging::instance::filter(logging::local::levs)) {
+            logging.err("Log levels must be of the form library:level");
+            throw local::except{};
+        }
+
+        logging::local::rate = config.get<int>(logging::local::rate_name);
+        logging::local::ratio = config.get<int>(logging::local::ratio_name);
+
+        if (!logging::instance::limit(logging::local::rate, logging::local::ratio)) {
+            logging.err("Log rate limit must be non-negative and log sample ratio must be positive");
+            throw local::except{};
+        }
+
+        cntrl::local::env_grvty = config.get<double>(cntrl::local::env_grvty_name);
+        cntrl::local::env_gcnst = config.get<double>(cntrl::local::env_gcnst_name);
+        cntrl::local::env_molar = config.get<double>(cntrl::local::env_molar_name);
+        cntrl::local::env_gamma = config.get<double>(cntrl::local::env_gamma_name);
+
+        cntrl::local::vhc_mass = config.get<double>(cntrl::local::vhc_mass_name);
+        cntrl::local::vhc_iner = config.get<double>(cntrl::local::vhc_iner_name);
+        cntrl::local::vhc_cmas = config.get<double>(cntrl::local::vhc_cmas_name);
+        cntrl::local::vhc_area = config.get<double>(cntrl::local::vhc_area_name);
+
+        cntrl::local::mpc_apog = config.get<double>(cntrl::local::mpc_apog_name);
+        cntrl::local::mpc_enab = config.get<double>(cntrl::local::mpc_enab_name);
+        cntrl::local::mpc_step = config.get<double>(cntrl::local::mpc_step_name);
+        cntrl::local::mpc_phrz = config.get<double>(cntrl::local::mpc_phrz_name);
+        cntrl::local::mpc_thrz = config.get<double>(cntrl::local::mpc_thrz_name);
+        cntrl::local::mpc_tol = config.get<double>(cntrl::local::mpc_tol_name);
+        cntrl::local::mpc_adap = config.get<bool>(cntrl::local::mpc_adap_name);
+        cntrl::local::mpc_atol = config.get<double>(cntrl::local::mpc_atol_name);
+        cntrl::local::mpc_dead = config.get<bool>(cntrl::local::mpc_dead_name);
+        cntrl::local::mpc_budg = config.get<double>(cntrl::local::mpc_budg_name);
+
+        for (int i = 0; i < 6; i++) {
+            cntrl::local::srf_range = config.get<linalg::fvector>(cntrl::local::srf_range_names[i]);
+            cntrl::local::srf_points = config.get<int>(cntrl::local::srf_points_names[i]);
+
+            if (linalg::dim(cntrl::local::srf_range) != 2 || cntrl::local::srf_range[0] >= cntrl::local::srf_range[1]) {
+                logging.err("Surface range must be an increasing pair");
+                throw local::except{};
+            }
+
+            if (cntrl::local::srf_points < 2) {
+                logging.err("Surface point count must be at least two");
+                throw local::except{};
+            }
+
+            srfwrite::local::lower.push_back(cntrl::local::srf_range[0]);
+            srfwrite::local::upper.push_back(cntrl::local::srf_range[1]);
+            srfwrite::local::count.push_back(cntrl::local::srf_points);
+
+            local::size *= cntrl::local::srf_points;
+        }
+
+        interrupt::instance interrupt;
+
+        cntrl::instance cntrl(
+                            cntrl::local::aer_path, cntrl::local::atm_path, cntrl::local::srf_path,
+                            cntrl::local::env_grvty, cntrl::local::env_gcnst, cntrl::local::env_molar, cntrl::local::env_gamma,
+                            cntrl::local::vhc_mass, cntrl::local::vhc_iner, cntrl::local::vhc_cmas, cntrl::local::vhc_area,
+                            cntrl::local::mpc_apog, cntrl::local::mpc_enab,
+                            cntrl::local::mpc_step, cntrl::local::mpc_phrz, cntrl::local::mpc_thrz, cntrl::local::mpc_tol,
+                            1, 1, false, cntrl::local::mpc_adap, cntrl::local::mpc_atol,
+                            cntrl::local::mpc_dead, cntrl::local::mpc_budg,
+                            false, true
+                        );
+
+        local::idx = std::vector<int>(6, 0);
+
+        for (int n = 0; n < local::size; n++) {
+            if (interrupt.caught()) {
+                logging.wrn("Tabulation interrupted");
+                throw local::except{};
+            }
+
+            linalg::resize(cntrl::local::estm, 4);
+            for (int i = 0; i < 4; i++) {
+                cntrl::local::estm[i] = srfwrite::local::lower[i]
+                                      + (srfwrite::local::upper[i] - srfwrite::local::lower[i])
+                                      * local::idx[i] / (srfwrite::local::count[i] - 1);
+            }
+            cntrl::local::attk = srfwrite::local::lower[4]
+                               + (srfwrite::local::upper[4] - srfwrite::local::lower[4])
+                               * local::idx[4] / (srfwrite::local::count[4] - 1);
+            cntrl::local::ctrl = srfwrite::local::lower[5]
+                               + (srfwrite::local::upper[5] - srfwrite::local::lower[5])
+                               * local::idx[5] / (srfwrite::local::count[5] - 1);
+
+            srfwrite::local::body.push_back(cntrl.get_apog(cntrl::local::ctrl, cntrl::local::estm, cntrl::local::attk));
+
+            for (int i = 5; i >= 0; i--) {
+                local::idx[i]++;
+                if (local::idx[i] < srfwrite::local::count[i]) {
+                    break;
+                }
+                local::idx[i] = 0;
+            }
+        }
+
+        srfwrite::instance srfwrite(srfwrite::local::path);
+
+        srfwrite.put_head(srfwrite::local::lower, srfwrite::local::upper, srfwrite::local::count);
+        srfwrite.put_body(srfwrite::local::body);
+    } catch (...) {
+        logging.wrn("Exiting");
+        logging::instance::stop();
+        return 1;
+    }
+
+    logging.inf("Exiting");
+    logging::instance::stop();
+
+    return 0;
+}
@@ -0,0 +1,390 @@
+#include <cmath>
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include <math/linalg.hpp>
+
+#include <sys/logging.hpp>
+#include <sys/timing.hpp>
+#include <sys/config.hpp>
+
+#include <ipc/sharedmem.hpp>
+
+#include <dyn/cntrl.hpp>
+
+namespace logging::local {
+    std::string path = "log/system.bin";
+    std::string app = "validator";
+    std::string lib = "main";
+
+    std::string levs_name = "log_levels", rate_name = "log_rate_limit", ratio_name = "log_sample_ratio";
+    std::vector<std::string> levs;
+    int rate, ratio;
+}
+
+namespace config::local {
+    std::string path = "config/controller.conf";
+}
+
+namespace sharedmem::local {
+    std::string name = "validator_";
+}
+
+namespace cntrl::local {
+    std::string env_grvty_name = "gravitational_acceleration",
+                env_gcnst_name = "ideal_gas_constant",
+                env_molar_name = "molar_mass",
+                env_gamma_name = "gamma_factor";
+
+    std::string vhc_mass_name = "mass",
+                vhc_iner_name = "moment_of_inertia",
+                vhc_cmas_name = "center_of_mass",
+                vhc_area_name = "cross_sectional_area";
+
+    std::string mpc_apog_name = "apogee_altitude",
+                mpc_enab_name = "enable_altitude",
+                mpc_step_name = "time_step",
+                mpc_phrz_name = "prediction_horizon",
+                mpc_thrz_name = "termination_horizon",
+                mpc_tol_name = "tolerance",
+                mpc_atol_name = "adaptive_tolerance";
+
+    std::vector<std::string> srf_range_names = {
+        "surface_altitude_range", "surface_angle_range", "surface_velocity_range", "surface_rate_range", "surface_brake_range"
+    };
+
+    std::string aer_path = "input/aerodynamic-data.csv", atm_path = "input/atmospheric-data.csv";
+    std::string srf_path = "input/apogee-surface.dat";
+    double env_grvty, env_gcnst, env_molar, env_gamma;
+    double vhc_mass, vhc_iner, vhc_cmas, vhc_area;
+    double mpc_apog, mpc_enab, mpc_step, mpc_phrz, mpc_thrz, mpc_tol;
+    double mpc_atol;
+
+    linalg::fvector srf_range;
+    std::vector<double> lower, upper;
+
+    std::vector<linalg::fvector> estm;
+    std::vector<double> ctrl;
+}
+
+namespace local {
+    std::string points_name = "validation_points", step_name = "validation_reference_step", tol_name = "validation_tolerance";
+    std::string ctol_name = "validation_control_tolerance", budg_name = "validation_budget";
+    int points;
+    double step, tol, ctol, budg;
+
+
+    enum class task {apog, ctrl, dead};
+
+    struct mode {
+        std::string name;
+        double step;
+        bool adap, srf;
+        task kind;
+    };
+
+    struct result {
+        int count, fail;
+        double time, ctrl;
+        bool conv;
+    };
+
+    std::vector<mode> modes;
+    std::vector<result> res;
+
+    std::vector<int> idx;
+    int size = 1;
+
+    class except {};
+}
+
+int main (void) {
+    if (!logging::instance::start(logging::local::path, logging::local::app)) {
+        return 1;
+    }
+
+    logging::instance logging(logging::local::lib);
+    logging.inf("Starting");
+
+    try {
+        config::instance config(config::local::path);
+
+        logging::local::levs = config.get<std::vector<std::string>>(logging::local::levs_name);
+
+        if (!logging::instance::filter(logging::local::levs)) {
+            logging.err("Log levels must be of the form library:level");
+            throw local::except{};
+        }
+
+        logging::local::rate = config.get<int>(logging::local::rate_name);
+        logging::local::ratio = config.get<int>(logging::local::ratio_name);
+
+        if (!logging::instance::limit(logging::local::rate, logging::local::ratio)) {
+            logging.err("Log rate limit must be non-negative and log sample ratio must be positive");
+            throw local::except{};
+        }
+
+        cntrl::local::env_grvty = config.get<double>(cntrl::local::env_grvty_name);
+        cntrl::local::env_gcnst = config.get<double>(cntrl::local::env_gcnst_name);
+        cntrl::local::env_molar = config.get<double>(cntrl::local::env_molar_name);
+        cntrl::local::env_gamma = config.get<double>(cntrl::local::env_gamma_name);
+
+        cntrl::local::vhc_mass = config.get<double>(cntrl::local::vhc_mass_name);
+        cntrl::local::vhc_iner = config.get<double>(cntrl::local::vhc_iner_name);
+        cntrl::local::vhc_cmas = config.get<double>(cntrl::local::vhc_cmas_name);
+        cntrl::local::vhc_area = config.get<double>(cntrl::local::vhc_area_name);
+
+        cntrl::local::mpc_apog = config.get<double>(cntrl::local::mpc_apog_name);
+        cntrl::local::mpc_enab = config.get<double>(cntrl::local::mpc_enab_name);
+        cntrl::local::mpc_step = config.get<double>(cntrl::local::mpc_step_name);
+        cntrl::local::mpc_phrz = config.get<double>(cntrl::local::mpc_phrz_name);
+        cntrl::local::mpc_thrz = config.get<double>(cntrl::local::mpc_thrz_name);
+        cntrl::local::mpc_tol = config.get<double>(cntrl::local::mpc_tol_name);
+        cntrl::local::mpc_atol = config.get<double>(cntrl::local::mpc_atol_name);
+
+        local::points = config.get<int>(local::points_name);
+        local::step = config.get<double>(local::step_name);
+        local::tol = config.get<double>(local::tol_name);
+        local::ctol = config.get<double>(local::ctol_name);
+        local::budg = config.get<double>(local::budg_name);
+
+        if (local::points < 2) {
+            logging.err("Validation point count must be at least two");
+            throw local::except{};
+        }
+
+        if (local::step <= 0 || local::step >= cntrl::local::mpc_step) {
+            logging.err("Validation reference step must be positive and smaller than the time step");
+            throw local::except{};
+        }
+
+        if (local::tol <= 0) {
+            logging.err("Validation tolerance must be positive");
+            throw local::except{};
+        }
+
+        if (local::ctol <= 0) {
+            logging.err("Validation control tolerance must be positive");
+            throw local::except{};
+        }
+
+        if (local::budg <= 0) {
+            logging.err("Validation budget must be positive");
+            throw local::except{};
+        }
+
+        for (int i = 0; i < 5; i++) {
+            cntrl::local::srf_range = config.get<linalg::fvector>(cntrl::local::srf_range_names[i]);
+
+            if (linalg::dim(cntrl::local::srf_range) != 2 || cntrl::local::srf_range[0] >= cntrl::local::srf_range[1]) {
+                logging.err("Surface range must be an increasing pair");
+                throw local::except{};
+            }
+
+            cntrl::local::lower.push_back(cntrl::local::srf_range[0]);
+            cntrl::local::upper.push_back(cntrl::local::srf_range[1]);
+
+            local::size *= local::points;
+        }
+
+        local::idx = std::vector<int>(5, 0);
+
+        for (int n = 0; n < local::size; n++) {
+            linalg::fvector estm(4);
+            for (int i = 0; i < 4; i++) {
+                estm[i] = cntrl::local::lower[i] + (cntrl::local::upper[i] - cntrl::local::lower[i]) * local::idx[i] / (local::points - 1);
+            }
+            cntrl::local::estm.push_back(estm);
+            cntrl::local::ctrl.push_back(cntrl::local::lower[4] + (cntrl::local::upper[4] - cntrl::local::lower[4]) * local::idx[4] / (local::points - 1));
+
+            for (int i = 4; i >= 0; i--) {
+                local::idx[i]++;
+                if (local::idx[i] < local::points) {
+                    break;
+                }
+                local::idx[i] = 0;
+            }
+        }
+
+        local::modes = {
+            {"Fixed step", cntrl::local::mpc_step, false, false, local::task::apog},
+            {"Adaptive step", cntrl::local::mpc_step, true, false, local::task::apog},
+            {"Reference", local::step, false, false, local::task::apog},
+            {"Deadline", cntrl::local::mpc_step, false, false, local::task::dead},
+            {"Integrated", cntrl::local::mpc_step, false, false, local::task::ctrl},
+            {"Surface", cntrl::local::mpc_step, false, true, local::task::ctrl}
+        };
+
+        linalg::fvector estm(4);
+        for (int i = 0; i < 4; i++) {
+            estm[i] = 0.5 * (cntrl::local::lower[i] + cntrl::local::upper[i]);
+        }
+
+        if (estm[0] <= cntrl::local::mpc_enab || estm[0] >= cntrl::local::mpc_apog || estm[2] <= 0) {
+            logging.err("Surface range midpoint must lie in the active control region");
+            throw local::except{};
+        }
+
+        timing::instance timing;
+
+        std::vector<std::unique_ptr<sharedmem::instance<local::result>>> memory;
+        std::vector<std::unique_ptr<sharedmem::instance<linalg::fvector>>> values;
+        std::vector<sharedmem::vecview<const double>> val;
+        for (int k = 0; k < int(local::modes.size()); k++) {
+            memory.push_back(
+                std::make_unique<sharedmem::instance<local::result>>(sharedmem::local::name + std::to_string(k), sharedmem::mode::both)
+            );
+            values.push_back(
+                std::make_unique<sharedmem::instance<linalg::fvector>>(
+                    sharedmem::local::name + "val_" + std::to_string(k), local::size, sharedmem::mode::both
+                )
+            );
+        }
+
+        for (int k = 0; k < int(local::modes.size()); k++) {
+            pid_t pid = fork();
+
+            if (pid < 0) {
+                logging.err("Failed to spawn evaluator #", k + 1);
+                throw local::except{};
+            }
+
+            if (pid == 0) {
+                local::result res;
+                int code = 0;
+
+                res.count = (local::modes[k].kind == local::task::apog) ? local::size :
+                            (local::modes[k].kind == local::task::ctrl) ? local::size / local::points : 0;
+                res.fail = 0;
+
+                try {
+                    cntrl::instance cntrl(
+                                        cntrl::local::aer_path, cntrl::local::atm_path, cntrl::local::srf_path,
+                                        cntrl::local::env_grvty, cntrl::local::env_gcnst, cntrl::local::env_molar, cntrl::local::env_gamma,
+                                        cntrl::local::vhc_mass, cntrl::local::vhc_iner, cntrl::local::vhc_cmas, cntrl::local::vhc_area,
+                                        cntrl::local::mpc_apog, cntrl::local::mpc_enab,
+                                        local::modes[k].step, cntrl::local::mpc_phrz, cntrl::local::mpc_thrz, cntrl::local::mpc_tol,
+                                        1, 1, false, local::modes[k].adap, cntrl::local::mpc_atol,
+                                        local::modes[k].kind == local::task::dead, (local::modes[k].kind == local::task::dead) ? local::budg : 1,
+                                        local::modes[k].srf, true
+                                    );
+
+                    auto val = values[k]->put_view();
+                    double strt = timing.get_time();
+
+                    if (local::modes[k].kind == local::task::dead) {
+                        res.ctrl = cntrl.get_ctrl(estm);
+                        res.conv = cntrl.get_conv();
+                    }
+
+                    for (int n = 0; n < res.count; n++) {
+                        try {
+                            if (local::modes[k].kind == local::task::ctrl) {
+                                val[n] = cntrl.get_ctrl(cntrl::local::estm[n * local::points]);
+                            } else {
+                                val[n] = cntrl.get_apog(cntrl::local::ctrl[n], cntrl::local::estm[n]);
+                            }
+                        } catch (...) {
+                            val[n] = NAN;
+                            res.fail++;
+                        }
+                    }
+
+                    res.time = timing.get_time() - strt;
+
+                    memory[k]->put(res);
+                } catch (...) {
+                    logging.err("Evaluator #", k + 1, " failed");
+                    code = 1;
+                }
+
+                logging::instance::stop();
+                _exit(code);
+            }
+
+            int stat;
+
+            waitpid(pid, &stat, 0);
+            if (!WIFEXITED(stat) || WEXITSTATUS(stat) != 0) {
+                logging.err("Evaluator #", k + 1, " exited abnormally");
+                throw local::except{};
+            }
+
+            local::res.push_back(memory[k]->get());
+            val.push_back(values[k]->get_view());
+        }
+
+        auto stats = [&val] (int k, int ref) {
+            double max = 0, sum = 0;
+            int count = 0;
+
+            for (int n = 0; n < local::res[k].count; n++) {
+                if (std::isnan(val[k][n]) || std::isnan(val[ref][n])) {
+                    continue;
+                }
+                max = std::max(max, std::fabs(val[k][n] - val[ref][n]));
+                sum += std::fabs(val[k][n] - val[ref][n]);
+                count++;
+            }
+
+            return std::vector<double>{max, count > 0 ? sum / count : 0.0};
+        };
+
+        std::cout << "Samples: " << local::size << ", Tolerance: " << local::tol << " m" << std::endl;
+
+        for (int k = 0; k < int(local::modes.size()); k++) {
+            std::cout << "    " << std::left << std::setw(14) << local::modes[k].name << std::right << std::fixed
+                      << " Step " << std::setprecision(4) << local::modes[k].step << " s"
+                      << "  Time " << std::setw(9) << std::setprecision(1) << local::res[k].time * 1e3 << " ms"
+                      << "  Failed " << local::res[k].fail << std::endl;
+        }
+
+        bool fail = false;
+
+        auto check = [&fail, &stats] (const std::string & label, int k, int ref, double tol, const std::string & unit) {
+            auto err = stats(k, ref);
+
+            std::cout << label << ": Max error " << std::fixed << std::setprecision(4) << err[0]
+                      << unit << ", Mean error " << err[1] << unit << std::endl;
+
+            if (err[0] > tol || local::res[k].fail != local::res[ref].fail) {
+                fail = true;
+            }
+        };
+
+        check("Adaptive step against fixed step", 1, 0, local::tol, " m");
+        check("Fixed step against reference", 0, 2, local::tol, " m");
+        check("Adaptive step against reference", 1, 2, local::tol, " m");
+        check("Surface control against integrated control", 5, 4, local::ctol, "");
+
+        std::cout << "Deadline fallback: Control " << std::fixed << std::setprecision(4) << local::res[3].ctrl
+                  << ", Converged: " << (local::res[3].conv ? "yes" : "no") << std::endl;
+
+        if (local::res[3].ctrl != 0 || local::res[3].conv) {
+            logging.err("Control signal past deadline must keep the brake retracted on a cold start");
+            fail = true;
+        }
+
+        if (fail) {
+            logging.err("Validation checks failed");
+            throw local::except{};
+        }
+    } catch (...) {
+        logging.wrn("Exiting");
+        logging::instance::stop();
+        return 1;
+    }
+
+    logging.inf("Exiting");
+    logging::instance::stop();
+
+    return 0;
+}
@@ -0,0 +1,70 @@
+#ifndef __DAT_LOGREAD_HPP__
+#define __DAT_LOGREAD_HPP__
+
+#include <cstddef>
+#include <cstdint>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <sys/logging.hpp>
+
+namespace logread {
+
+class tracker {
+    protected:
+        static int count;
+        static int instantiate (void);
+};
+
+class instance : private tracker {
+    public:
+        instance (const std::string & path);
+
+        std::int64_t get_time (void);
+        std::string get_line (void);
+
+        enum class except_ctor {fail};
+        enum class except_get_time {fail, eof};
+        enum class except_get_line {fail, eof};
+
+    private:
+        struct table {
+            std::string app;
+            std::vector<std::string> strs;
+        };
+
+        struct entry {
+            std::int64_t time;
+            std::string text;
+        };
+
+        logging::instance logging;
+        bool init;
+        int id;
+
+        std::map<std::uint32_t, table> tabs;
+        std::vector<entry> lines;
+        int idx;
+
+        void parse_frame (std::uint32_t pid, const std::string & data);
+        void parse_line (table & tab, const std::string & data);
+        void parse_drop (table & tab, const std::string & data);
+        std::size_t parse_field (table & tab, const std::string & data, std::size_t pos, logging::stream & strm);
+
+        void fetch (const std::string & data, std::size_t & pos, void * dst, std::size_t size);
+        void head (std::ostream & text, std::int64_t time, std::uint8_t lev, const std::string & app, const std::string & lib);
+
+        enum class except_parse_frame {fail};
+        enum class except_parse_line {fail};
+        enum class except_parse_drop {fail};
+        enum class except_parse_field {fail};
+        enum class except_fetch {fail};
+
+        class except_intern {};
+};
+
+}
+
+#endif
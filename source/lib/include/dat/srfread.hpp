@@ -0,0 +1,52 @@
+#ifndef __DAT_SRFREAD_HPP__
+#define __DAT_SRFREAD_HPP__
+
+#include <cstddef>
+
+#include <string>
+#include <vector>
+
+#include <sys/logging.hpp>
+
+namespace srfread {
+
+class tracker {
+    protected:
+        static int count;
+        static int instantiate (void);
+};
+
+class instance : private tracker {
+    public:
+        instance (const std::string & path);
+        ~instance (void);
+
+        std::vector<double> get_lower (void);
+        std::vector<double> get_upper (void);
+        std::vector<int> get_count (void);
+        const double * get_body (void);
+
+        enum class except_ctor {fail};
+        enum class except_get_lower {fail};
+        enum class except_get_upper {fail};
+        enum class except_get_count {fail};
+        enum class except_get_body {fail};
+
+    private:
+        logging::instance logging;
+        bool init;
+        int id;
+
+        void * data;
+        std::size_t len;
+
+        std::vector<double> lower, upper;
+        std::vector<int> count;
+        const double * body;
+
+        class except_intern {};
+};
+
+}
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef __DYN_AERTAB_HPP__
+#define __DYN_AERTAB_HPP__
+
+#include <string>
+#include <vector>
+
+#include <sys/logging.hpp>
+
+namespace aertab {
+
+class tracker {
+    protected:
+        static int count;
+        static int instantiate (void);
+};
+
+class instance : private tracker {
+    public:
+        struct hint {
+            int attk, mach, brak;
+        };
+
+        instance (const std::string & path);
+
+        void find (double attk, double mach, double brak, double & lift, double & drag, double & cprs, hint & hint);
+
+        enum class except_ctor {fail};
+        enum class except_find {fail};
+
+    private:
+        struct alignas(32) entry {
+            double coef[4];
+        };
+
+        logging::instance logging;
+        bool init;
+        int id;
+
+        std::vector<double> attk, mach, brak;
+        double attk_step, mach_step, brak_step;
+        std::vector<entry> data;
+
+        void load (const std::string & path);
+
+        enum class except_load {fail};
+};
+
+}
+
+#endif
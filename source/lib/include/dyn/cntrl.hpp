@@ -1,12 +1,20 @@
 #ifndef __DYN_CNTRL_HPP__
 #define __DYN_CNTRL_HPP__
 
+#include <array>
+#include <optional>
 #include <string>
 #include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
 
 #include <math/linalg.hpp>
 #include <sys/logging.hpp>
 #include <dat/csvread.hpp>
+#include <dat/srfread.hpp>
+#include <dyn/aertab.hpp>
 
 namespace cntrl {
 
@@ -19,45 +27,118 @@ class tracker {
 class instance : private tracker {
     public:
         instance (
-            const std::string & aer_path, const std::string & atm_path,
+            const std::string & aer_path, const std::string & atm_path, const std::string & srf_path,
             double env_grvty, double env_gcnst, double env_molar, double env_gamma,
             double vhc_mass, double vhc_iner, double vhc_cmas, double vhc_area,
-            double mpc_apog, double mpc_enab, double mpc_step, double mpc_phrz, double mpc_thrz, double mpc_tol
+            double mpc_apog, double mpc_enab, double mpc_step, double mpc_phrz, double mpc_thrz, double mpc_tol,
+            int mpc_wrkr, int mpc_btch, bool mpc_warm, bool mpc_adap, double mpc_atol, bool mpc_dead, double mpc_budg,
+            bool srf_used, bool srf_fall
         );
+        ~instance (void);
 
         double get_ctrl (const linalg::fvector & estm);
+        int get_eval (void);
+        bool get_conv (void);
+        double get_apog (double ctrl, const linalg::fvector & estm);
+        double get_apog (double ctrl, const linalg::fvector & estm, double attk);
 
         enum class except_ctor {fail};
         enum class except_get_ctrl {fail};
+        enum class except_get_eval {fail};
+        enum class except_get_conv {fail};
+        enum class except_get_apog {fail};
 
     private:
+        struct alignas(64) wrkr {
+            int atm_hint;
+            aertab::instance::hint aer_hint;
+        };
+
+        struct alignas(64) cand {
+            double ctrl;
+            int categ;
+            bool fail, late;
+        };
+
+        struct alignas(64) btch {
+            static const int size = 16;
+            double val[6][size];
+        };
+
         logging::instance logging;
         bool init;
 
-        csvread::instance aer_dat, atm_dat;
-        std::vector<double> aer_attk, aer_mach, aer_brak;
-        std::vector<std::vector<std::vector<double>>> aer_lift, aer_drag, aer_cprs;
+        aertab::instance aer_tab;
+        csvread::instance atm_dat;
         std::vector<double> atm_altd, atm_pres, atm_temp, atm_dens;
+        double atm_step;
+        std::optional<srfread::instance> srf_dat;
+        double srf_lower[6], srf_upper[6], srf_step[6];
+        int srf_count[6], srf_stride[6];
+        const double * srf_body;
         double env_grvty, env_gcnst, env_molar, env_gamma;
         double vhc_mass, vhc_iner, vhc_cmas, vhc_area;
         double mpc_apog, mpc_enab, mpc_step, mpc_phrz, mpc_thrz, mpc_tol;
+        int mpc_wrkr, mpc_btch;
+        bool mpc_warm, mpc_adap;
+        double mpc_atol;
+        bool mpc_dead;
+        double mpc_budg;
+        bool srf_used, srf_fall;
+
+        double warm_ctrl;
+        bool warm_used;
+        int eval_count;
+        bool eval_conv;
+        std::chrono::steady_clock::time_point eval_dead;
 
-        void aer_load (void);
-        void aer_find (double attk, double mach, double brak, double & lift, double & drag, double & cprs);
+        std::vector<wrkr> wrkr_dat;
+        std::vector<cand> cand_dat;
+        std::vector<std::thread> wrkr_thrd;
+        std::mutex wrkr_mutx;
+        std::condition_variable wrkr_cond_strt, wrkr_cond_done;
+        const linalg::fvector * wrkr_estm;
+        int wrkr_size, wrkr_round, wrkr_pend;
+        bool wrkr_stop;
 
         void atm_load (void);
-        void atm_find (double altd, double & pres, double & temp, double & dens);
+        void atm_find (wrkr & wrkr, double altd, double & pres, double & temp, double & dens);
+
+        void srf_load (const std::string & path);
+        bool srf_find (const std::array<double, 6> & stat, double brak, double & apog);
+
+        void comp_dead (void);
+        void comp_stat (const linalg::fvector & estm, double attk, std::array<double, 6> & stat);
+        void comp_derv (wrkr & wrkr, double ctrl, const std::array<double, 6> & stat, std::array<double, 6> & derv);
+        void comp_pred (wrkr & wrkr, double ctrl, const std::array<double, 6> & stat, std::array<double, 6> & pred);
+        void comp_term (wrkr & wrkr, double ctrl, const std::array<double, 6> & pred, std::array<double, 6> & term);
+        void comp_adap (wrkr & wrkr, double ctrl, const std::array<double, 6> & pred, std::array<double, 6> & term);
+        void comp_apex (const std::array<double, 6> & prev, const std::array<double, 6> & next, double step, std::array<double, 6> & apex);
+        void comp_apog (wrkr & wrkr, double ctrl, const std::array<double, 6> & pred, double & apog);
+        void comp_categ (wrkr & wrkr, double ctrl, const linalg::fvector & estm, int & categ);
+
+        void btch_derv (wrkr & wrkr, int size, const double * ctrl, const btch & stat, btch & derv);
+        void btch_step (wrkr & wrkr, int size, const double * ctrl, const bool * live, btch & stat);
+        void btch_pred (wrkr & wrkr, int size, const double * ctrl, btch & pred);
+        void btch_term (wrkr & wrkr, int size, const double * ctrl, btch & term);
+        void btch_categ (wrkr & wrkr, int size, struct cand * cand, const linalg::fvector & estm);
 
-        void comp_stat (const linalg::fvector & estm, linalg::fvector & stat);
-        void comp_derv (double ctrl, const linalg::fvector & stat, linalg::fvector & derv);
-        void comp_pred (double ctrl, const linalg::fvector & stat, linalg::fvector & pred);
-        void comp_term (double ctrl, const linalg::fvector & pred, linalg::fvector & term);
-        void comp_categ (double ctrl, const linalg::fvector & estm, int & categ);
+        void wrkr_start (void);
+        void wrkr_halt (void);
+        void wrkr_loop (int idx);
+        void wrkr_work (int idx);
+        bool wrkr_eval (const linalg::fvector & estm, int size);
 
-        enum class except_aer_load {fail};
         enum class except_atm_load {fail};
+        enum class except_srf_load {fail};
+        enum class except_comp_dead {late};
         enum class except_comp_term {fail};
+        enum class except_comp_apog {fail};
         enum class except_comp_categ {fail};
+        enum class except_btch_term {fail};
+        enum class except_btch_categ {fail};
+        enum class except_wrkr_start {fail};
+        enum class except_wrkr_eval {fail};
 };
 
 }
@@ -31,6 +31,8 @@ class instance : private tracker {
 
         csvread::instance atm_dat;
         std::vector<double> atm_pres, atm_altd;
+        double atm_step;
+        int atm_hint;
         int regr_count, regr_idx;
         double regr_time, regr_sum_pos, regr_sum_time, regr_sum_pos_time, regr_sum_time_time;
         double kalm_time, kalm_pos_var, kalm_acc_var, kalm_acc;
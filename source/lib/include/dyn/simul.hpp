@@ -7,6 +7,7 @@
 #include <math/linalg.hpp>
 #include <sys/logging.hpp>
 #include <dat/csvread.hpp>
+#include <dyn/aertab.hpp>
 
 namespace simul {
 
@@ -49,10 +50,12 @@ class instance : private tracker {
         logging::instance logging;
         bool init;
 
-        csvread::instance aer_dat, atm_dat;
-        std::vector<double> aer_attk, aer_mach, aer_brak;
-        std::vector<std::vector<std::vector<double>>> aer_lift, aer_drag, aer_cprs;
+        aertab::instance aer_tab;
+        aertab::instance::hint aer_hint;
+        csvread::instance atm_dat;
         std::vector<double> atm_altd, atm_pres, atm_temp, atm_dens;
+        double atm_step;
+        int atm_hint;
         double env_grvty, env_gcnst, env_molar, env_gamma;
         double vhc_mass, vhc_iner, vhc_cmas, vhc_area;
         linalg::fmatrix imu_rot_var, imu_qua_var, imu_lia_var;
@@ -66,9 +69,6 @@ class instance : private tracker {
         linalg::fvector stat, sens;
         bool time_prev_valid, time_curr_valid, ctrl_valid, stat_valid, sens_valid;
 
-        void aer_load (void);
-        void aer_find (double attk, double mach, double brak, double & lift, double & drag, double & cprs);
-
         void atm_load (void);
         void atm_find (double altd, double & pres, double & temp, double & dens);
 
@@ -79,7 +79,6 @@ class instance : private tracker {
         void comp_derv (double ctrl, const linalg::fvector & stat, linalg::fvector & derv);
         void comp_sens (double time, double ctrl, const linalg::fvector & stat, linalg::fvector & sens);
 
-        enum class except_aer_load {fail};
         enum class except_atm_load {fail};
 };
 
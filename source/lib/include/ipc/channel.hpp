@@ -1,14 +1,25 @@
 #ifndef __IPC_CHANNEL_HPP__
 #define __IPC_CHANNEL_HPP__
 
+#include <cstddef>
+#include <cstdint>
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include <pthread.h>
+
 #include <math/linalg.hpp>
 #include <sys/logging.hpp>
 #include <ipc/semaphore.hpp>
-#include <ipc/sharedmem.hpp>
+#include <ipc/seqlock.hpp>
 
 namespace channel {
 
 enum class mode {none, create, remove, both};
+enum class sync {lock, free, prio};
+enum class role {reader, writer};
 
 class tracker {
     protected:
@@ -18,21 +29,63 @@ class tracker {
 
 class instance : private tracker {
     public:
+        struct stamp {
+            std::uint32_t seq;
+            double time, orig;
+        };
+
+        struct batch {
+            bool ctrl_put = false, stat_put = false, estm_put = false, sens_put = false;
+            bool ctrl_get = false, stat_get = false, estm_get = false, sens_get = false;
+            double ctrl;
+            linalg::fvector stat, estm, sens;
+            bool ctrl_drdy, stat_drdy, estm_drdy, sens_drdy;
+            stamp ctrl_stmp, stat_stmp, estm_stmp, sens_stmp;
+        };
+
         instance (mode mode = mode::none);
+        instance (const std::string & name, const std::string & acces, mode mode = mode::none);
+        ~instance (void);
 
         void put_ctrl (double ctrl);
+        void put_ctrl (double ctrl, double orig);
         void put_stat (const linalg::fvector & stat);
+        void put_stat (const linalg::fvector & stat, double orig);
         void put_estm (const linalg::fvector & estm);
+        void put_estm (const linalg::fvector & estm, double orig);
         void put_sens (const linalg::fvector & sens);
+        void put_sens (const linalg::fvector & sens, double orig);
 
         double get_ctrl (void);
+        double get_ctrl (stamp & stamp);
         linalg::fvector get_stat (void);
+        linalg::fvector get_stat (stamp & stamp);
         linalg::fvector get_estm (void);
+        linalg::fvector get_estm (stamp & stamp);
         linalg::fvector get_sens (void);
+        linalg::fvector get_sens (stamp & stamp);
+
+        std::vector<double> drain_ctrl (int & lost);
+        std::vector<double> drain_ctrl (int & lost, std::vector<stamp> & stamp);
+        std::vector<linalg::fvector> drain_stat (int & lost);
+        std::vector<linalg::fvector> drain_stat (int & lost, std::vector<stamp> & stamp);
+        std::vector<linalg::fvector> drain_estm (int & lost);
+        std::vector<linalg::fvector> drain_estm (int & lost, std::vector<stamp> & stamp);
+        std::vector<linalg::fvector> drain_sens (int & lost);
+        std::vector<linalg::fvector> drain_sens (int & lost, std::vector<stamp> & stamp);
+
+        void transact (batch & batch);
+        void transact (batch & batch, double orig);
+
+        void wait_ctrl (double dur);
+        void wait_stat (double dur);
+        void wait_estm (double dur);
+        void wait_sens (double dur);
 
         void clear (void);
+        void set_sync (sync sync);
 
-        void acquire (void);
+        void acquire (role role = role::writer);
         void release (void);
 
         enum class except_ctor {fail};
@@ -44,19 +97,110 @@ class instance : private tracker {
         enum class except_get_stat {fail, blank};
         enum class except_get_estm {fail, blank};
         enum class except_get_sens {fail, blank};
+        enum class except_drain_ctrl {fail};
+        enum class except_drain_stat {fail};
+        enum class except_drain_estm {fail};
+        enum class except_drain_sens {fail};
+        enum class except_transact {fail};
+        enum class except_wait_ctrl {fail, timeout};
+        enum class except_wait_stat {fail, timeout};
+        enum class except_wait_estm {fail, timeout};
+        enum class except_wait_sens {fail, timeout};
         enum class except_clear {fail};
+        enum class except_set_sync {fail};
         enum class except_acquire {fail};
         enum class except_release {fail};
 
     private:
+        static const std::uint32_t ring_size = 1024;
+
+        template <int dim>
+        struct alignas(64) topic {
+            seqlock::counter seq, wait, head, ownr;
+            bool drdy;
+            stamp stmp;
+            double data[dim];
+        };
+
+        template <int dim>
+        struct slot {
+            seqlock::counter seq;
+            stamp stmp;
+            double data[dim];
+        };
+
+        template <int dim>
+        struct alignas(64) ring {
+            slot<dim> data[ring_size];
+        };
+
+        struct alignas(64) segment {
+            std::uint32_t vers;
+            std::atomic<sync> disc;
+            pthread_mutex_t mutx;
+            topic<1> ctrl;
+            topic<7> stat;
+            topic<4> estm;
+            topic<17> sens;
+            ring<1> ctrl_ring;
+            ring<7> stat_ring;
+            ring<4> estm_ring;
+            ring<17> sens_ring;
+        };
+
+        static const std::uint32_t seg_vers = 6;
+        static const int retry_limit = 64;
+
+        enum class status {done, held, slot, torn, blank};
+
         logging::instance logging;
         bool init;
 
-        bool locked;
+        bool locked, writer, held, owned;
         semaphore::instance acces;
-        sharedmem::instance<bool> ctrl_drdy, stat_drdy, estm_drdy, sens_drdy;
-        sharedmem::instance<double> ctrl_data;
-        sharedmem::instance<linalg::fvector> stat_data, estm_data, sens_data;
+        segment * seg;
+        std::uint32_t ctrl_last, stat_last, estm_last, sens_last;
+        std::uint32_t ctrl_curs, stat_curs, estm_curs, sens_curs;
+        std::string name;
+        std::size_t len;
+        bool create, remove;
+
+        template <int dim>
+        status write (topic<dim> & topic, ring<dim> & ring, const double * data, double orig);
+
+        template <int dim>
+        status write_lock (topic<dim> & topic, ring<dim> & ring);
+
+        template <int dim>
+        void write_data (topic<dim> & topic, ring<dim> & ring, const double * data, double orig);
+
+        template <int dim>
+        void write_unlock (topic<dim> & topic, ring<dim> & ring);
+
+        template <int dim>
+        void write_abort (topic<dim> & topic, ring<dim> & ring);
+
+        template <int dim>
+        status read (topic<dim> & topic, ring<dim> & ring, double * data, stamp & stamp, std::uint32_t & last);
+
+        template <int dim>
+        bool recover (topic<dim> & topic, ring<dim> & ring);
+
+        template <int dim>
+        void repair (topic<dim> & topic, ring<dim> & ring);
+
+        void repair (void);
+
+        int mutx_init (bool prio);
+
+        static bool check_ctrl (double ctrl);
+        static bool check_stat (const linalg::fvector & stat);
+        static bool check_estm (const linalg::fvector & estm);
+        static bool check_sens (const linalg::fvector & sens);
+
+        static double time_now (void);
+
+        class except_intern {};
 };
 
 }
@@ -0,0 +1,27 @@
+#ifndef __IPC_SEQLOCK_HPP__
+#define __IPC_SEQLOCK_HPP__
+
+#include <cstdint>
+
+#include <atomic>
+
+namespace seqlock {
+
+typedef std::atomic<std::uint32_t> counter;
+
+bool write_begin (counter & seq);
+void write_end (counter & seq);
+void repair (counter & seq);
+
+bool claim (counter & own, std::uint32_t val);
+void leave (counter & own);
+
+bool read_begin (const counter & seq, std::uint32_t & val);
+bool read_retry (const counter & seq, std::uint32_t val);
+
+bool wait (counter & seq, counter & cnt, std::uint32_t val, double dur);
+void wake (counter & seq, counter & cnt);
+
+}
+
+#endif
@@ -5,6 +5,7 @@
 #include <cstdint>
 
 #include <string>
+#include <type_traits>
 
 #include <math/linalg.hpp>
 #include <sys/logging.hpp>
@@ -20,68 +21,47 @@ class tracker {
 };
 
 template <typename type>
-class instance;
-
-template <>
-class instance<std::uint8_t> : private tracker {
+class vecview {
     public:
-        instance (const std::string & name, mode mode = mode::none);
-        ~instance (void);
+        vecview (type * data, int dim);
 
-        void put (std::uint8_t val);
-        std::uint8_t get (void);
+        type & operator [] (int idx) const;
 
-        enum class except_ctor {fail};
-        enum class except_put {fail};
-        enum class except_get {fail};
+        int dim (void) const;
 
     private:
-        logging::instance logging;
-        bool init;
-        int id;
-
-        std::uint8_t * data;
-        std::string name;
-        std::size_t len;
-        bool create, remove;
-
-        class except_intern {};
+        type * data;
+        int len;
 };
 
-template <>
-class instance<bool> : private tracker {
+template <typename type>
+class matview {
     public:
-        instance (const std::string & name, mode mode = mode::none);
-        ~instance (void);
+        matview (type * data, int rows, int cols);
 
-        void put (bool val);
-        bool get (void);
+        type * operator [] (int idx) const;
 
-        enum class except_ctor {fail};
-        enum class except_put {fail};
-        enum class except_get {fail};
+        int rows (void) const;
+        int cols (void) const;
 
     private:
-        logging::instance logging;
-        bool init;
-        int id;
-
-        bool * data;
-        std::string name;
-        std::size_t len;
-        bool create, remove;
-
-        class except_intern {};
+        type * data;
+        int nrow, ncol;
 };
 
-template <>
-class instance<int> : private tracker {
+template <typename type>
+class instance : private tracker {
+    static_assert(std::is_trivially_copyable_v<type>);
+    static_assert(std::is_default_constructible_v<type>);
+    static_assert(sizeof(type) <= (1 << 24));
+    static_assert(alignof(type) <= 4096);
+
     public:
         instance (const std::string & name, mode mode = mode::none);
         ~instance (void);
 
-        void put (int val);
-        int get (void);
+        void put (const type & val);
+        type get (void);
 
         enum class except_ctor {fail};
         enum class except_put {fail};
@@ -92,36 +72,15 @@ class instance<int> : private tracker {
         bool init;
         int id;
 
-        int * data;
+        type * data;
         std::string name;
         std::size_t len;
         bool create, remove;
 
-        class except_intern {};
-};
-
-template <>
-class instance<double> : private tracker {
-    public:
-        instance (const std::string & name, mode mode = mode::none);
-        ~instance (void);
+        static constexpr bool scalar =
+            std::is_same_v<type, std::uint8_t> || std::is_same_v<type, bool> || std::is_same_v<type, int> || std::is_same_v<type, double>;
 
-        void put (double val);
-        double get (void);
-
-        enum class except_ctor {fail};
-        enum class except_put {fail};
-        enum class except_get {fail};
-
-    private:
-        logging::instance logging;
-        bool init;
-        int id;
-
-        double * data;
-        std::string name;
-        std::size_t len;
-        bool create, remove;
+        static const char * type_name (void);
 
         class except_intern {};
 };
@@ -135,9 +94,14 @@ class instance<linalg::ivector> : private tracker {
         void put (const linalg::ivector & val);
         linalg::ivector get (void);
 
+        vecview<int> put_view (void);
+        vecview<const int> get_view (void);
+
         enum class except_ctor {fail};
         enum class except_put {fail};
         enum class except_get {fail};
+        enum class except_put_view {fail};
+        enum class except_get_view {fail};
 
     private:
         logging::instance logging;
@@ -162,9 +126,14 @@ class instance<linalg::fvector> : private tracker {
         void put (const linalg::fvector & val);
         linalg::fvector get (void);
 
+        vecview<double> put_view (void);
+        vecview<const double> get_view (void);
+
         enum class except_ctor {fail};
         enum class except_put {fail};
         enum class except_get {fail};
+        enum class except_put_view {fail};
+        enum class except_get_view {fail};
 
     private:
         logging::instance logging;
@@ -189,9 +158,14 @@ class instance<linalg::imatrix> : private tracker {
         void put (const linalg::imatrix & val);
         linalg::imatrix get (void);
 
+        matview<int> put_view (void);
+        matview<const int> get_view (void);
+
         enum class except_ctor {fail};
         enum class except_put {fail};
         enum class except_get {fail};
+        enum class except_put_view {fail};
+        enum class except_get_view {fail};
 
     private:
         logging::instance logging;
@@ -216,9 +190,14 @@ class instance<linalg::fmatrix> : private tracker {
         void put (const linalg::fmatrix & val);
         linalg::fmatrix get (void);
 
+        matview<double> put_view (void);
+        matview<const double> get_view (void);
+
         enum class except_ctor {fail};
         enum class except_put {fail};
         enum class except_get {fail};
+        enum class except_put_view {fail};
+        enum class except_get_view {fail};
 
     private:
         logging::instance logging;
@@ -236,4 +215,6 @@ class instance<linalg::fmatrix> : private tracker {
 
 }
 
+#include <ipc/sharedmem.tpp>
+
 #endif
@@ -0,0 +1,13 @@
+#ifndef __MATH_LOOKUP_HPP__
+#define __MATH_LOOKUP_HPP__
+
+#include <vector>
+
+namespace lookup {
+
+double step (const std::vector<double> & node);
+int find (const std::vector<double> & node, double step, double val, int & hint);
+
+}
+
+#endif
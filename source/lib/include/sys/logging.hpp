@@ -1,58 +1,203 @@
 #ifndef __SYS_LOGGING_HPP__
 #define __SYS_LOGGING_HPP__
 
+#include <cstddef>
 #include <cstdint>
 
+#include <atomic>
 #include <iomanip>
 #include <iostream>
 #include <fstream>
+#include <map>
+#include <sstream>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 #include <math/linalg.hpp>
 
+#ifndef LOGGING_LEVEL
+#define LOGGING_LEVEL 0
+#endif
+
 namespace logging {
 
+enum class mode {shared, split};
+
 class stream;
 
+class record {
+    public:
+        enum class tag : std::uint8_t {
+            chr, str, byte, bin, num, flt, ivec, fvec, imat, fmat, list, trnc, sid
+        };
+
+        enum class kind : std::uint8_t {proc, defn, line, drop};
+
+        static const std::uint32_t magic = 0x474F4C43;
+
+        record (char * data, std::size_t cap);
+
+        void put (const char * val);
+
+        void put (const std::string & val);
+        void put (std::uint8_t val);
+        void put (bool val);
+        void put (int val);
+        void put (double val);
+        void put (const linalg::ivector & val);
+        void put (const linalg::fvector & val);
+        void put (const linalg::imatrix & val);
+        void put (const linalg::fmatrix & val);
+
+        template <typename type>
+        void put (const std::vector<type> & val);
+
+        template <typename type, typename = std::enable_if_t<std::is_enum_v<type>>>
+        void put (const type & val);
+
+        void put_head (std::int64_t time, std::uint64_t site, std::uint8_t lev, const std::string & lib);
+
+        std::size_t seal (void);
+
+    private:
+        char * data;
+        std::size_t cap, len;
+        bool trnc;
+
+        bool room (std::size_t size);
+        void raw (const void * src, std::size_t size);
+        void mark (tag tag);
+};
+
+class origin {
+    public:
+        origin (const char * text, const char * file = __builtin_FILE(), int line = __builtin_LINE());
+
+        const char * text;
+        std::uint64_t key;
+};
+
 class instance {
     public:
-        static bool start (const std::string & path, const std::string & app);
+        static bool start (const std::string & path, const std::string & app, mode mode = mode::shared);
         static void stop (void);
 
+        static bool filter (const std::vector<std::string> & levs);
+        static bool limit (int rate, int ratio);
+
         instance (const std::string & lib);
 
         template <typename ... types>
-        void inf (const types & ... args);
+        void inf (const origin & orig, const types & ... args);
 
         template <typename ... types>
-        void wrn (const types & ... args);
+        void wrn (const origin & orig, const types & ... args);
 
         template <typename ... types>
-        void err (const types & ... args);
+        void err (const origin & orig, const types & ... args);
 
     private:
+        enum class level : std::uint8_t {inf, wrn, err};
+
+        static constexpr level base = static_cast<level>(LOGGING_LEVEL);
+
+        static const std::uint64_t ring_size = 1024;
+        static const std::size_t cell_size = 1024;
+        static const int drain_period = 1;
+
+        static const std::size_t site_count = 1024;
+        static const std::size_t text_size = 64;
+        static const std::int64_t report_period = 1000000000;
+
+        struct cell {
+            std::atomic<std::uint64_t> seq;
+            std::size_t len;
+            char data[cell_size];
+        };
+
+        struct site {
+            std::atomic<std::uint64_t> key;
+            std::atomic<const std::string *> lib;
+            char text[text_size];
+            std::atomic<std::uint64_t> hits;
+            std::atomic<std::int64_t> slot;
+            std::atomic<int> pass;
+            std::atomic<int> supp;
+        };
+
         static bool init;
         static int desc;
         static std::ofstream file;
+        static std::string bin;
+        static std::string path;
         static std::string app;
-        static stream strm;
+        static mode layout;
+
+        static cell ring[ring_size];
+        static std::atomic<std::uint64_t> ring_head;
+        static std::uint64_t ring_tail;
+        static std::atomic<int> drop;
+
+        static std::atomic<bool> run;
+        static std::thread * thrd;
+        static std::mutex mutx;
+        static bool hook;
+        static bool fresh;
+        static std::unordered_map<std::string, std::uint32_t> strs;
+
+        static std::mutex thrs_mutx;
+        static level thrs_base;
+
+        static site sites[site_count];
+        static std::atomic<int> rate;
+        static std::atomic<int> ratio;
+        static std::int64_t last;
 
         std::string lib;
+        std::atomic<level> * thrs;
+        const std::string * name;
+
+        static std::map<std::string, std::atomic<level>> & thrs_libs (void);
+        static std::map<std::string, level> & thrs_over (void);
+
+        static bool parse (const std::string & str, level & lev);
+
+        static cell * claim (void);
+        static void commit (cell * cell, std::size_t len);
+
+        static void drain (void);
+        static bool flush (void);
+        static void encode (const char * data, std::size_t len);
+        static std::size_t field (const char * data, std::size_t pos, std::size_t len, std::string & line);
+        static std::uint32_t intern (const std::string & str);
+        static void entry (record::kind kind, const std::string & data);
+        static void report (std::int64_t time);
+
+        static bool attach (void);
+        static void detach (void);
+
+        static void prepare (void);
+        static void parent (void);
+        static void child (void);
+
+        bool admit (std::uint64_t key, std::int64_t time, const char * text);
 
-        void head (const std::string & lev);
-        void body (void);
+        void body (record & rec);
 
         template <typename type, typename ... types>
-        void body (const type & arg, const types & ... args);
+        void body (record & rec, const type & arg, const types & ... args);
 
         template <typename ... types>
-        void msg (const std::string & lev, const types & ... args);
+        void msg (level lev, const origin & orig, const types & ... args);
 };
 
 class stream {
     public:
-        stream (std::ofstream & file);
+        stream (std::ostream & file);
 
         stream & operator << (const char * val);
 
@@ -77,7 +222,7 @@ class stream {
         stream & operator << (const std::vector<linalg::fmatrix> & val);
 
     private:
-        std::ofstream * file;
+        std::ostream * file;
 };
 
 }
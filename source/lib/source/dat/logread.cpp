@@ -0,0 +1,436 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <math/linalg.hpp>
+#include <sys/logging.hpp>
+#include <dat/logread.hpp>
+
+namespace logread {
+
+int tracker::count = 0;
+
+int tracker::instantiate (void) {
+    tracker::count++;
+    return tracker::count;
+}
+
+instance::instance (const std::string & path) : logging("logread"), init(false), id(instance::instantiate()), idx(0) {
+    bool file_open = false;
+    std::uint32_t head[3];
+    std::ifstream file;
+    std::string data;
+
+    this->logging.inf("Initializing instance #", this->id, ": Path: ", path);
+
+    try {
+        this->logging.inf("Opening log file #", this->id);
+        file.clear();
+        file.open(path, std::ios::binary);
+        if (file.fail()) {
+            this->logging.err("Failed to open log file #", this->id, " (", std::strerror(errno), ")");
+            throw except_intern{};
+        }
+
+        file_open = true;
+
+        while (true) {
+            this->logging.inf("Reading frame from log file #", this->id);
+            file.clear();
+            file.read(reinterpret_cast<char *>(head), sizeof(head));
+            if (file.fail()) {
+                if (file.eof() && file.gcount() == 0) {
+                    this->logging.inf("No more frames in log file #", this->id);
+                    break;
+                } else if (file.eof()) {
+                    this->logging.wrn("Truncated frame in log file #", this->id);
+                    break;
+                } else {
+                    this->logging.err("Failed to read frame from log file #", this->id, " (", std::strerror(errno), ")");
+                    throw except_intern{};
+                }
+            }
+
+            if (head[0] != logging::record::magic) {
+                this->logging.err("Failed to read frame from log file #", this->id, " (Bad magic number)");
+                throw except_intern{};
+            }
+
+            data.resize(head[2]);
+
+            file.clear();
+            file.read(data.data(), data.size());
+            if (file.fail()) {
+                if (file.eof()) {
+                    this->logging.wrn("Truncated frame in log file #", this->id);
+                    break;
+                } else {
+                    this->logging.err("Failed to read frame from log file #", this->id, " (", std::strerror(errno), ")");
+                    throw except_intern{};
+                }
+            }
+            this->logging.inf("Read frame from log file #", this->id, ": Process: ", int(head[1]), ", Size: ", int(head[2]));
+
+            try {
+                this->parse_frame(head[1], data);
+            } catch (except_parse_frame) {
+                throw except_intern{};
+            }
+        }
+
+        file_open = false;
+
+        this->logging.inf("Closing log file #", this->id);
+        file.clear();
+        file.close();
+        if (file.fail()) {
+            this->logging.err("Failed to close log file #", this->id, " (", std::strerror(errno), ")");
+            throw except_intern{};
+        }
+
+        auto pred = [] (const entry & lhs, const entry & rhs) {
+            return lhs.time < rhs.time;
+        };
+
+        std::stable_sort(this->lines.begin(), this->lines.end(), pred);
+    } catch (except_intern) {
+        if (file_open) {
+            this->logging.wrn("Closing log file #", this->id);
+            file.clear();
+            file.close();
+            if (file.fail()) {
+                this->logging.err("Failed to close log file #", this->id, " (", std::strerror(errno), ")");
+            }
+        }
+
+        this->logging.err("Failed to initialize instance #", this->id);
+        throw except_ctor::fail;
+    }
+
+    this->init = true;
+}
+
+std::int64_t instance::get_time (void) {
+    this->logging.inf("Getting time from log file #", this->id);
+
+    if (!this->init) {
+        this->logging.err("Failed to get time from log file #", this->id, " (Instance not initialized)");
+        throw except_get_time::fail;
+    }
+
+    if (this->idx == int(this->lines.size())) {
+        this->logging.wrn("No more lines in log file #", this->id);
+        throw except_get_time::eof;
+    }
+
+    this->logging.inf("Got time from log file #", this->id);
+
+    return this->lines[this->idx].time;
+}
+
+std::string instance::get_line (void) {
+    this->logging.inf("Getting line from log file #", this->id);
+
+    if (!this->init) {
+        this->logging.err("Failed to get line from log file #", this->id, " (Instance not initialized)");
+        throw except_get_line::fail;
+    }
+
+    if (this->idx == int(this->lines.size())) {
+        this->logging.wrn("No more lines in log file #", this->id);
+        throw except_get_line::eof;
+    }
+
+    this->idx++;
+
+    this->logging.inf("Got line from log file #", this->id, ": Line: ", this->lines[this->idx - 1].text);
+
+    return this->lines[this->idx - 1].text;
+}
+
+void instance::parse_frame (std::uint32_t pid, const std::string & data) {
+    std::size_t pos = 0;
+    std::uint8_t kind;
+    std::uint32_t sid;
+    std::string body;
+    int size;
+
+    this->logging.inf("Parsing frame");
+
+    try {
+        while (pos < data.size()) {
+            this->fetch(data, pos, &kind, sizeof(kind));
+            this->fetch(data, pos, &size, sizeof(size));
+
+            if (size < 0 || pos + size > data.size()) {
+                this->logging.err("Failed to parse frame (Entry truncated)");
+                throw except_parse_frame::fail;
+            }
+
+            body = data.substr(pos, size);
+            pos += size;
+
+            if (static_cast<logging::record::kind>(kind) == logging::record::kind::proc) {
+                this->tabs[pid] = table{body, {}};
+                continue;
+            }
+
+            auto itr = this->tabs.find(pid);
+            if (itr == this->tabs.end()) {
+                this->logging.err("Failed to parse frame (Unknown process)");
+                throw except_parse_frame::fail;
+            }
+
+            table & tab = itr->second;
+
+            if (static_cast<logging::record::kind>(kind) == logging::record::kind::defn) {
+                std::size_t off = 0;
+
+                this->fetch(body, off, &sid, sizeof(sid));
+                if (sid != tab.strs.size()) {
+                    this->logging.err("Failed to parse frame (Bad string index)");
+                    throw except_parse_frame::fail;
+                }
+
+                tab.strs.push_back(body.substr(off));
+            } else if (static_cast<logging::record::kind>(kind) == logging::record::kind::line) {
+                this->parse_line(tab, body);
+            } else if (static_cast<logging::record::kind>(kind) == logging::record::kind::drop) {
+                this->parse_drop(tab, body);
+            } else {
+                this->logging.err("Failed to parse frame (Unknown entry)");
+                throw except_parse_frame::fail;
+            }
+        }
+    } catch (except_fetch) {
+        throw except_parse_frame::fail;
+    } catch (except_parse_line) {
+        throw except_parse_frame::fail;
+    } catch (except_parse_drop) {
+        throw except_parse_frame::fail;
+    }
+
+    this->logging.inf("Parsed frame");
+}
+
+void instance::parse_line (table & tab, const std::string & data) {
+    std::size_t pos = 0;
+    std::int64_t time;
+    std::uint64_t site;
+    std::uint8_t lev;
+    std::uint32_t sid;
+    std::ostringstream text;
+    logging::stream strm(text);
+
+    this->logging.inf("Parsing line");
+
+    try {
+        this->fetch(data, pos, &time, sizeof(time));
+        this->fetch(data, pos, &site, sizeof(site));
+        this->fetch(data, pos, &lev, sizeof(lev));
+        this->fetch(data, pos, &sid, sizeof(sid));
+
+        if (sid >= tab.strs.size()) {
+            this->logging.err("Failed to parse line (Bad string index)");
+            throw except_parse_line::fail;
+        }
+
+        this->head(text, time, lev, tab.app, tab.strs[sid]);
+
+        while (pos < data.size()) {
+            pos = this->parse_field(tab, data, pos, strm);
+        }
+    } catch (except_fetch) {
+        throw except_parse_line::fail;
+    } catch (except_parse_field) {
+        throw except_parse_line::fail;
+    }
+
+    this->lines.push_back(entry{time, text.str()});
+
+    this->logging.inf("Parsed line");
+}
+
+void instance::parse_drop (table & tab, const std::string & data) {
+    std::size_t pos = 0;
+    std::int64_t time;
+    std::ostringstream text;
+    logging::stream strm(text);
+    int lost;
+
+    this->logging.inf("Parsing drop");
+
+    try {
+        this->fetch(data, pos, &time, sizeof(time));
+        this->fetch(data, pos, &lost, sizeof(lost));
+    } catch (except_fetch) {
+        throw except_parse_drop::fail;
+    }
+
+    this->head(text, time, 1, tab.app, "logging");
+    strm << "Dropped " << lost << " messages";
+
+    this->lines.push_back(entry{time, text.str()});
+
+    this->logging.inf("Parsed drop");
+}
+
+std::size_t instance::parse_field (table & tab, const std::string & data, std::size_t pos, logging::stream & strm) {
+    logging::record::tag tag;
+    std::uint32_t sid;
+    int size, rows, cols;
+
+    try {
+        this->fetch(data, pos, &tag, sizeof(tag));
+
+        if (tag == logging::record::tag::sid) {
+            this->fetch(data, pos, &sid, sizeof(sid));
+
+            if (sid >= tab.strs.size()) {
+                this->logging.err("Failed to parse field (Bad string index)");
+                throw except_parse_field::fail;
+            }
+
+            strm << tab.strs[sid].c_str();
+        } else if (tag == logging::record::tag::chr || tag == logging::record::tag::str) {
+            this->fetch(data, pos, &size, sizeof(size));
+
+            std::string val(size, '\0');
+            this->fetch(data, pos, val.data(), size);
+
+            if (tag == logging::record::tag::chr) {
+                strm << val.c_str();
+            } else {
+                strm << val;
+            }
+        } else if (tag == logging::record::tag::byte) {
+            std::uint8_t val;
+            this->fetch(data, pos, &val, sizeof(val));
+            strm << val;
+        } else if (tag == logging::record::tag::bin) {
+            bool val;
+            this->fetch(data, pos, &val, sizeof(val));
+            strm << val;
+        } else if (tag == logging::record::tag::num) {
+            int val;
+            this->fetch(data, pos, &val, sizeof(val));
+            strm << val;
+        } else if (tag == logging::record::tag::flt) {
+            double val;
+            this->fetch(data, pos, &val, sizeof(val));
+            strm << val;
+        } else if (tag == logging::record::tag::ivec) {
+            this->fetch(data, pos, &size, sizeof(size));
+
+            linalg::ivector val(size);
+            for (int i = 0; i < size; i++) {
+                this->fetch(data, pos, &val[i], sizeof(int));
+            }
+            strm << val;
+        } else if (tag == logging::record::tag::fvec) {
+            this->fetch(data, pos, &size, sizeof(size));
+
+            linalg::fvector val(size);
+            for (int i = 0; i < size; i++) {
+                this->fetch(data, pos, &val[i], sizeof(double));
+            }
+            strm << val;
+        } else if (tag == logging::record::tag::imat) {
+            this->fetch(data, pos, &rows, sizeof(rows));
+            this->fetch(data, pos, &cols, sizeof(cols));
+
+            linalg::imatrix val(rows, cols);
+            for (int i = 0; i < rows; i++) {
+                for (int j = 0; j < cols; j++) {
+                    this->fetch(data, pos, &val[i][j], sizeof(int));
+                }
+            }
+            strm << val;
+        } else if (tag == logging::record::tag::fmat) {
+            this->fetch(data, pos, &rows, sizeof(rows));
+            this->fetch(data, pos, &cols, sizeof(cols));
+
+            linalg::fmatrix val(rows, cols);
+            for (int i = 0; i < rows; i++) {
+                for (int j = 0; j < cols; j++) {
+                    this->fetch(data, pos, &val[i][j], sizeof(double));
+                }
+            }
+            strm << val;
+        } else if (tag == logging::record::tag::list) {
+            this->fetch(data, pos, &size, sizeof(size));
+
+            strm << "{";
+            for (int i = 0; i < size && pos < data.size(); i++) {
+                if (static_cast<logging::record::tag>(data[pos]) == logging::record::tag::trnc) {
+                    break;
+                }
+                pos = this->parse_field(tab, data, pos, strm);
+                strm << (i < size - 1 ? ", " : "");
+            }
+            strm << "}";
+        } else if (tag == logging::record::tag::trnc) {
+            strm << " ...";
+            pos = data.size();
+        } else {
+            this->logging.err("Failed to parse field (Unknown tag)");
+            throw except_parse_field::fail;
+        }
+    } catch (except_fetch) {
+        throw except_parse_field::fail;
+    }
+
+    return pos;
+}
+
+void instance::fetch (const std::string & data, std::size_t & pos, void * dst, std::size_t size) {
+    if (pos + size > data.size()) {
+        this->logging.err("Failed to fetch bytes (Entry truncated)");
+        throw except_fetch::fail;
+    }
+
+    std::memcpy(dst, data.data() + pos, size);
+    pos += size;
+}
+
+void instance::head (std::ostream & text, std::int64_t time, std::uint8_t lev, const std::string & app, const std::string & lib) {
+    auto tstamp = std::chrono::steady_clock::duration(time);
+    auto hour = std::chrono::duration_cast<std::chrono::hours>(tstamp);
+    auto min = std::chrono::duration_cast<std::chrono::minutes>(tstamp);
+    auto sec = std::chrono::duration_cast<std::chrono::seconds>(tstamp);
+    auto msec = std::chrono::duration_cast<std::chrono::milliseconds>(tstamp);
+    auto usec = std::chrono::duration_cast<std::chrono::microseconds>(tstamp);
+
+    usec -= msec;
+    msec -= sec;
+    sec -= min;
+    min -= hour;
+
+    text << "["
+         << std::setfill('0') << std::setw(2) << hour.count()
+         << ":"
+         << std::setfill('0') << std::setw(2) << min.count()
+         << ":"
+         << std::setfill('0') << std::setw(2) << sec.count()
+         << "."
+         << std::setfill('0') << std::setw(3) << msec.count()
+         << ","
+         << std::setfill('0') << std::setw(3) << usec.count()
+         << "] "
+         << "<" << (lev == 0 ? "inf" : lev == 1 ? "wrn" : "err") << "> "
+         << app << "/" << lib << ": "
+         << std::setfill(' ');
+}
+
+}
@@ -0,0 +1,210 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+#include <sys/logging.hpp>
+#include <dat/srfread.hpp>
+
+namespace srfread {
+
+int tracker::count = 0;
+
+int tracker::instantiate (void) {
+    tracker::count++;
+    return tracker::count;
+}
+
+instance::instance (const std::string & path) : logging("srfread"), init(false), id(instance::instantiate()), len(0) {
+    bool file_open = false, file_map = false;
+    int ret, desc;
+    struct stat info;
+    const char * magic = "CABSRF01";
+    const char * head;
+    std::int32_t dim, cnt;
+    double low, upp;
+    std::size_t size = 1, offs;
+
+    this->logging.inf("Initializing instance #", this->id, ": Path: ", path);
+
+    try {
+        this->logging.inf("Opening surface file #", this->id);
+        desc = open(path.c_str(), O_RDONLY);
+        if (desc < 0) {
+            this->logging.err("Failed to open surface file #", this->id, " (", std::strerror(errno), ")");
+            throw except_intern{};
+        }
+
+        file_open = true;
+
+        ret = fstat(desc, &info);
+        if (ret < 0) {
+            this->logging.err("Failed to open surface file #", this->id, " (", std::strerror(errno), ")");
+            throw except_intern{};
+        }
+
+        this->len = info.st_size;
+
+        if (this->len < 16) {
+            this->logging.err("Failed to open surface file #", this->id, " (Truncated file)");
+            throw except_intern{};
+        }
+
+        this->logging.inf("Mapping surface file #", this->id);
+        this->data = mmap(NULL, this->len, PROT_READ, MAP_SHARED, desc, 0);
+        if (this->data == MAP_FAILED) {
+            this->logging.err("Failed to map surface file #", this->id, " (", std::strerror(errno), ")");
+            throw except_intern{};
+        }
+
+        file_map = true;
+
+        file_open = false;
+
+        this->logging.inf("Closing surface file #", this->id);
+        ret = close(desc);
+        if (ret < 0) {
+            this->logging.err("Failed to close surface file #", this->id, " (", std::strerror(errno), ")");
+            throw except_intern{};
+        }
+
+        head = (const char *)this->data;
+
+        if (std::memcmp(head, magic, 8) != 0) {
+            this->logging.err("Failed to read surface file #", this->id, " (Invalid format)");
+            throw except_intern{};
+        }
+
+        std::memcpy(&dim, head + 8, sizeof(dim));
+
+        if (dim <= 0) {
+            this->logging.err("Failed to read surface file #", this->id, " (Invalid dimension)");
+            throw except_intern{};
+        }
+
+        offs = 16 + 24 * std::size_t(dim);
+
+        if (this->len < offs) {
+            this->logging.err("Failed to read surface file #", this->id, " (Truncated file)");
+            throw except_intern{};
+        }
+
+        for (int i = 0; i < dim; i++) {
+            std::memcpy(&low, head + 16 + 24 * i, sizeof(low));
+            std::memcpy(&upp, head + 24 + 24 * i, sizeof(upp));
+            std::memcpy(&cnt, head + 32 + 24 * i, sizeof(cnt));
+
+            if (!(low < upp) || cnt < 2) {
+                this->logging.err("Failed to read surface file #", this->id, " (Invalid axis)");
+                throw except_intern{};
+            }
+
+            this->lower.push_back(low);
+            this->upper.push_back(upp);
+            this->count.push_back(cnt);
+
+            size *= cnt;
+        }
+
+        if (this->len != offs + size * sizeof(double)) {
+            this->logging.err("Failed to read surface file #", this->id, " (Inconsistent size)");
+            throw except_intern{};
+        }
+
+        this->body = (const double *)(head + offs);
+    } catch (except_intern) {
+        if (file_open) {
+            this->logging.wrn("Closing surface file #", this->id);
+            ret = close(desc);
+            if (ret < 0) {
+                this->logging.err("Failed to close surface file #", this->id, " (", std::strerror(errno), ")");
+            }
+        }
+
+        if (file_map) {
+            this->logging.wrn("Unmapping surface file #", this->id);
+            ret = munmap(this->data, this->len);
+            if (ret < 0) {
+                this->logging.err("Failed to unmap surface file #", this->id, " (", std::strerror(errno), ")");
+            }
+        }
+
+        this->logging.err("Failed to initialize instance #", this->id);
+        throw except_ctor::fail;
+    }
+
+    this->init = true;
+}
+
+instance::~instance (void) {
+    int ret;
+
+    if (this->init) {
+        this->logging.inf("Unmapping surface file #", this->id);
+        ret = munmap(this->data, this->len);
+        if (ret < 0) {
+            this->logging.err("Failed to unmap surface file #", this->id, " (", std::strerror(errno), ")");
+        }
+    }
+}
+
+std::vector<double> instance::get_lower (void) {
+    this->logging.inf("Getting lower bounds from surface file #", this->id);
+
+    if (!this->init) {
+        this->logging.err("Failed to get lower bounds from surface file #", this->id, " (Instance not initialized)");
+        throw except_get_lower::fail;
+    }
+
+    this->logging.inf("Got lower bounds from surface file #", this->id, ": Lower: ", this->lower);
+
+    return this->lower;
+}
+
+std::vector<double> instance::get_upper (void) {
+    this->logging.inf("Getting upper bounds from surface file #", this->id);
+
+    if (!this->init) {
+        this->logging.err("Failed to get upper bounds from surface file #", this->id, " (Instance not initialized)");
+        throw except_get_upper::fail;
+    }
+
+    this->logging.inf("Got upper bounds from surface file #", this->id, ": Upper: ", this->upper);
+
+    return this->upper;
+}
+
+std::vector<int> instance::get_count (void) {
+    this->logging.inf("Getting point counts from surface file #", this->id);
+
+    if (!this->init) {
+        this->logging.err("Failed to get point counts from surface file #", this->id, " (Instance not initialized)");
+        throw except_get_count::fail;
+    }
+
+    this->logging.inf("Got point counts from surface file #", this->id, ": Count: ", this->count);
+
+    return this->count;
+}
+
+const double * instance::get_body (void) {
+    this->logging.inf("Getting body from surface file #", this->id);
+
+    if (!this->init) {
+        this->logging.err("Failed to get body from surface file #", this->id, " (Instance not initialized)");
+        throw except_get_body::fail;
+    }
+
+    return this->body;
+}
+
+}
@@ -0,0 +1,136 @@
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <sys/logging.hpp>
+#include <dat/srfwrite.hpp>
+
+namespace srfwrite {
+
+int tracker::count = 0;
+
+int tracker::instantiate (void) {
+    tracker::count++;
+    return tracker::count;
+}
+
+instance::instance (const std::string & path) : logging("srfwrite"), init(false), id(instance::instantiate()), size(0) {
+    this->logging.inf("Initializing instance #", this->id, ": Path: ", path);
+
+    this->logging.inf("Opening surface file #", this->id);
+    this->file.clear();
+    this->file.open(path, std::ios::binary | std::ios::trunc);
+    if (this->file.fail()) {
+        this->logging.err("Failed to open surface file #", this->id, " (", std::strerror(errno), ")");
+        this->logging.err("Failed to initialize instance #", this->id);
+        throw except_ctor::fail;
+    }
+
+    this->init = true;
+}
+
+instance::~instance (void) {
+    if (this->init) {
+        this->logging.inf("Closing surface file #", this->id);
+        this->file.clear();
+        this->file.close();
+        if (this->file.fail()) {
+            this->logging.err("Failed to close surface file #", this->id, " (", std::strerror(errno), ")");
+        }
+    }
+}
+
+void instance::put_head (const std::vector<double> & lower, const std::vector<double> & upper, const std::vector<int> & count) {
+    const char magic[8] = {'C', 'A', 'B', 'S', 'R', 'F', '0', '1'};
+    std::int32_t dim, cnt, pad = 0;
+
+    this->logging.inf("Writing head to surface file #", this->id, ": Lower: ", lower, ", Upper: ", upper, ", Count: ", count);
+
+    if (!this->init) {
+        this->logging.err("Failed to write head to surface file #", this->id, " (Instance not initialized)");
+        throw except_put_head::fail;
+    }
+
+    if (this->size != 0) {
+        this->logging.err("Failed to write head to surface file #", this->id, " (Head already written)");
+        throw except_put_head::fail;
+    }
+
+    if (lower.empty() || lower.size() != upper.size() || lower.size() != count.size()) {
+        this->logging.err("Failed to write head to surface file #", this->id, " (Invalid dimension)");
+        throw except_put_head::fail;
+    }
+
+    for (int i = 0; i < int(lower.size()); i++) {
+        if (!(lower[i] < upper[i]) || count[i] < 2) {
+            this->logging.err("Failed to write head to surface file #", this->id, " (Invalid axis)");
+            throw except_put_head::fail;
+        }
+    }
+
+    dim = lower.size();
+
+    this->file.clear();
+    this->file.write(magic, sizeof(magic));
+    this->file.write((const char *)&dim, sizeof(dim));
+    this->file.write((const char *)&pad, sizeof(pad));
+    for (int i = 0; i < dim; i++) {
+        cnt = count[i];
+        this->file.write((const char *)&lower[i], sizeof(double));
+        this->file.write((const char *)&upper[i], sizeof(double));
+        this->file.write((const char *)&cnt, sizeof(cnt));
+        this->file.write((const char *)&pad, sizeof(pad));
+    }
+
+    if (this->file.fail()) {
+        this->logging.err("Failed to write head to surface file #", this->id, " (", std::strerror(errno), ")");
+        throw except_put_head::fail;
+    }
+
+    this->size = 1;
+    for (auto elem : count) {
+        this->size *= elem;
+    }
+}
+
+void instance::put_body (const std::vector<double> & body) {
+    this->logging.inf("Writing body to surface file #", this->id, ": Size: ", int(body.size()));
+
+    if (!this->init) {
+        this->logging.err("Failed to write body to surface file #", this->id, " (Instance not initialized)");
+        throw except_put_body::fail;
+    }
+
+    if (this->size == 0) {
+        this->logging.err("Failed to write body to surface file #", this->id, " (Head not written)");
+        throw except_put_body::fail;
+    }
+
+    if (this->size < 0) {
+        this->logging.err("Failed to write body to surface file #", this->id, " (Body already written)");
+        throw except_put_body::fail;
+    }
+
+    if (int(body.size()) != this->size) {
+        this->logging.err("Failed to write body to surface file #", this->id, " (Inconsistent dimension)");
+        throw except_put_body::fail;
+    }
+
+    this->file.clear();
+    this->file.write((const char *)body.data(), body.size() * sizeof(double));
+    this->file.flush();
+
+    if (this->file.fail()) {
+        this->logging.err("Failed to write body to surface file #", this->id, " (", std::strerror(errno), ")");
+        throw except_put_body::fail;
+    }
+
+    this->size = -1;
+}
+
+}
@@ -0,0 +1,215 @@
+#include <iterator>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <math/lookup.hpp>
+#include <sys/logging.hpp>
+#include <dat/csvread.hpp>
+#include <dyn/aertab.hpp>
+
+namespace aertab {
+
+int tracker::count = 0;
+
+int tracker::instantiate (void) {
+    tracker::count++;
+    return tracker::count;
+}
+
+instance::instance (const std::string & path) : logging("aertab"), init(false), id(instance::instantiate()) {
+    this->logging.inf("Initializing instance #", this->id, ": Path: ", path);
+
+    try {
+        this->load(path);
+    } catch (...) {
+        this->logging.err("Failed to initialize instance #", this->id);
+        throw except_ctor::fail;
+    }
+
+    this->init = true;
+}
+
+void instance::find (double attk, double mach, double brak, double & lift, double & drag, double & cprs, hint & hint) {
+    int attk_idx1, attk_idx2, mach_idx1, mach_idx2, brak_idx1, brak_idx2;
+    double attk_mean, mach_mean, brak_mean, attk_diff, mach_diff, brak_diff;
+    double coef_mean[3], coef_grad_attk[3], coef_grad_mach[3], coef_grad_brak[3];
+    const entry * corn[8];
+    int mach_size, brak_size;
+
+    if (!this->init) {
+        this->logging.err("Failed to look up aerodynamic coefficients in table #", this->id, " (Instance not initialized)");
+        throw except_find::fail;
+    }
+
+    attk_idx1 = lookup::find(this->attk, this->attk_step, attk, hint.attk);
+    attk_idx2 = attk_idx1 + 1;
+
+    mach_idx1 = lookup::find(this->mach, this->mach_step, mach, hint.mach);
+    mach_idx2 = mach_idx1 + 1;
+
+    brak_idx1 = lookup::find(this->brak, this->brak_step, brak, hint.brak);
+    brak_idx2 = brak_idx1 + 1;
+
+    mach_size = this->mach.size();
+    brak_size = this->brak.size();
+
+    corn[0] = &this->data[(attk_idx1 * mach_size + mach_idx1) * brak_size + brak_idx1];
+    corn[1] = &this->data[(attk_idx1 * mach_size + mach_idx1) * brak_size + brak_idx2];
+    corn[2] = &this->data[(attk_idx1 * mach_size + mach_idx2) * brak_size + brak_idx1];
+    corn[3] = &this->data[(attk_idx1 * mach_size + mach_idx2) * brak_size + brak_idx2];
+    corn[4] = &this->data[(attk_idx2 * mach_size + mach_idx1) * brak_size + brak_idx1];
+    corn[5] = &this->data[(attk_idx2 * mach_size + mach_idx1) * brak_size + brak_idx2];
+    corn[6] = &this->data[(attk_idx2 * mach_size + mach_idx2) * brak_size + brak_idx1];
+    corn[7] = &this->data[(attk_idx2 * mach_size + mach_idx2) * brak_size + brak_idx2];
+
+    attk_mean = 0.5 * (this->attk[attk_idx1] + this->attk[attk_idx2]);
+    mach_mean = 0.5 * (this->mach[mach_idx1] + this->mach[mach_idx2]);
+    brak_mean = 0.5 * (this->brak[brak_idx1] + this->brak[brak_idx2]);
+
+    attk_diff = attk - attk_mean;
+    mach_diff = mach - mach_mean;
+    brak_diff = brak - brak_mean;
+
+    for (int j = 0; j < 3; j++) {
+        coef_mean[j] = 0;
+        coef_grad_attk[j] = 0;
+        coef_grad_mach[j] = 0;
+        coef_grad_brak[j] = 0;
+    }
+
+    for (int i = 0; i < 8; i++) {
+        for (int j = 0; j < 3; j++) {
+            coef_mean[j] += corn[i]->coef[j];
+            coef_grad_attk[j] += (i & 4) ? corn[i]->coef[j] : -corn[i]->coef[j];
+            coef_grad_mach[j] += (i & 2) ? corn[i]->coef[j] : -corn[i]->coef[j];
+            coef_grad_brak[j] += (i & 1) ? corn[i]->coef[j] : -corn[i]->coef[j];
+        }
+    }
+
+    for (int j = 0; j < 3; j++) {
+        coef_mean[j] = 0.125 * coef_mean[j];
+        coef_grad_attk[j] = 0.25 * coef_grad_attk[j] / (this->attk[attk_idx2] - this->attk[attk_idx1]);
+        coef_grad_mach[j] = 0.25 * coef_grad_mach[j] / (this->mach[mach_idx2] - this->mach[mach_idx1]);
+        coef_grad_brak[j] = 0.25 * coef_grad_brak[j] / (this->brak[brak_idx2] - this->brak[brak_idx1]);
+    }
+
+    lift = coef_mean[0] + coef_grad_attk[0] * attk_diff + coef_grad_mach[0] * mach_diff + coef_grad_brak[0] * brak_diff;
+    drag = coef_mean[1] + coef_grad_attk[1] * attk_diff + coef_grad_mach[1] * mach_diff + coef_grad_brak[1] * brak_diff;
+    cprs = coef_mean[2] + coef_grad_attk[2] * attk_diff + coef_grad_mach[2] * mach_diff + coef_grad_brak[2] * brak_diff;
+}
+
+void instance::load (const std::string & path) {
+    std::vector<std::string> head;
+    std::vector<double> body;
+    std::vector<std::vector<double>> data;
+    std::vector<bool> covered;
+    double attk, mach, brak, lift, drag, cprs;
+    int attk_col, mach_col, brak_col, lift_col, drag_col, cprs_col;
+    int attk_idx, mach_idx, brak_idx, idx;
+
+    this->logging.inf("Creating aerodynamic lookup table #", this->id);
+
+    try {
+        csvread::instance csvread(path);
+
+        head = csvread.get_head();
+
+        attk_col = std::distance(head.begin(), std::find(head.begin(), head.end(), "Angle of attack (rad)"));
+        mach_col = std::distance(head.begin(), std::find(head.begin(), head.end(), "Mach number"));
+        brak_col = std::distance(head.begin(), std::find(head.begin(), head.end(), "Brake deployment"));
+        lift_col = std::distance(head.begin(), std::find(head.begin(), head.end(), "Lift coefficient"));
+        drag_col = std::distance(head.begin(), std::find(head.begin(), head.end(), "Drag coefficient"));
+        cprs_col = std::distance(head.begin(), std::find(head.begin(), head.end(), "Center of pressure (m)"));
+
+        if (
+               attk_col == int(head.size()) || mach_col == int(head.size()) || brak_col == int(head.size())
+            || lift_col == int(head.size()) || drag_col == int(head.size()) || cprs_col == int(head.size())
+        ) {
+            this->logging.err("Failed to create aerodynamic lookup table #", this->id, " (Missing column)");
+            throw except_load::fail;
+        }
+
+        try {
+            while (true) {
+                body = csvread.get_body();
+
+                attk = body[attk_col];
+                mach = body[mach_col];
+                brak = body[brak_col];
+                lift = body[lift_col];
+                drag = body[drag_col];
+                cprs = body[cprs_col];
+
+                data.push_back({attk, mach, brak, lift, drag, cprs});
+            }
+        } catch (csvread::instance::except_get_body except) {
+            switch (except) {
+                case csvread::instance::except_get_body::fail:
+                    this->logging.err("Failed to create aerodynamic lookup table #", this->id);
+                    throw except_load::fail;
+                case csvread::instance::except_get_body::eof:
+                    break;
+            }
+        }
+    } catch (csvread::instance::except_ctor) {
+        this->logging.err("Failed to create aerodynamic lookup table #", this->id);
+        throw except_load::fail;
+    } catch (csvread::instance::except_get_head) {
+        this->logging.err("Failed to create aerodynamic lookup table #", this->id);
+        throw except_load::fail;
+    }
+
+    for (auto itr = data.begin(); itr < data.end(); itr++) {
+        if (!std::binary_search(this->attk.begin(), this->attk.end(), (*itr)[0])) {
+            this->attk.insert(std::lower_bound(this->attk.begin(), this->attk.end(), (*itr)[0]), (*itr)[0]);
+        }
+        if (!std::binary_search(this->mach.begin(), this->mach.end(), (*itr)[1])) {
+            this->mach.insert(std::lower_bound(this->mach.begin(), this->mach.end(), (*itr)[1]), (*itr)[1]);
+        }
+        if (!std::binary_search(this->brak.begin(), this->brak.end(), (*itr)[2])) {
+            this->brak.insert(std::lower_bound(this->brak.begin(), this->brak.end(), (*itr)[2]), (*itr)[2]);
+        }
+    }
+
+    if (this->attk.size() < 2 || this->mach.size() < 2 || this->brak.size() < 2) {
+        this->logging.err("Failed to create aerodynamic lookup table #", this->id, " (Insufficient data)");
+        throw except_load::fail;
+    }
+
+    this->data = std::vector<entry>(this->attk.size() * this->mach.size() * this->brak.size());
+    covered = std::vector<bool>(this->data.size(), false);
+
+    for (auto itr = data.begin(); itr < data.end(); itr++) {
+        attk_idx = std::distance(this->attk.begin(), std::find(this->attk.begin(), this->attk.end(), (*itr)[0]));
+        mach_idx = std::distance(this->mach.begin(), std::find(this->mach.begin(), this->mach.end(), (*itr)[1]));
+        brak_idx = std::distance(this->brak.begin(), std::find(this->brak.begin(), this->brak.end(), (*itr)[2]));
+
+        idx = (attk_idx * this->mach.size() + mach_idx) * this->brak.size() + brak_idx;
+
+        if (covered[idx]) {
+            this->logging.err("Failed to create aerodynamic lookup table #", this->id, " (Repeated data point)");
+            throw except_load::fail;
+        }
+
+        this->data[idx].coef[0] = (*itr)[3];
+        this->data[idx].coef[1] = (*itr)[4];
+        this->data[idx].coef[2] = (*itr)[5];
+        this->data[idx].coef[3] = 0;
+
+        covered[idx] = true;
+    }
+
+    for (auto elem : covered) {
+        if (!elem) {
+            this->logging.err("Failed to create aerodynamic lookup table #", this->id, " (Missing data point)");
+            throw except_load::fail;
+        }
+    }
+
+    this->attk_step = lookup::step(this->attk);
+    this->mach_step = lookup::step(this->mach);
+    this->brak_step = lookup::step(this->brak);
+}
+
+}
@@ -2,14 +2,41 @@
 
 #include <iterator>
 #include <algorithm>
+#include <array>
+#include <optional>
 #include <string>
 #include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
 
 #include <math/linalg.hpp>
+#include <math/lookup.hpp>
 #include <sys/logging.hpp>
 #include <dat/csvread.hpp>
+#include <dat/srfread.hpp>
+#include <dyn/aertab.hpp>
 #include <dyn/cntrl.hpp>
 
+namespace cntrl::intern {
+
+const double dopr_a[7][6] = {
+    {0, 0, 0, 0, 0, 0},
+    {1.0 / 5, 0, 0, 0, 0, 0},
+    {3.0 / 40, 9.0 / 40, 0, 0, 0, 0},
+    {44.0 / 45, -56.0 / 15, 32.0 / 9, 0, 0, 0},
+    {19372.0 / 6561, -25360.0 / 2187, 64448.0 / 6561, -212.0 / 729, 0, 0},
+    {9017.0 / 3168, -355.0 / 33, 46732.0 / 5247, 49.0 / 176, -5103.0 / 18656, 0},
+    {35.0 / 384, 0, 500.0 / 1113, 125.0 / 192, -2187.0 / 6784, 11.0 / 84}
+};
+
+const double dopr_e[7] = {
+    71.0 / 57600, 0, -71.0 / 16695, 71.0 / 1920, -17253.0 / 339200, 22.0 / 525, -1.0 / 40
+};
+
+}
+
 namespace cntrl {
 
 bool tracker::exist = false;
@@ -24,24 +51,33 @@ bool tracker::instantiate (void) {
 }
 
 instance::instance (
-    const std::string & aer_path, const std::string & atm_path,
+    const std::string & aer_path, const std::string & atm_path, const std::string & srf_path,
     double env_grvty, double env_gcnst, double env_molar, double env_gamma,
     double vhc_mass, double vhc_iner, double vhc_cmas, double vhc_area,
-    double mpc_apog, double mpc_enab, double mpc_step, double mpc_phrz, double mpc_thrz, double mpc_tol
+    double mpc_apog, double mpc_enab, double mpc_step, double mpc_phrz, double mpc_thrz, double mpc_tol,
+    int mpc_wrkr, int mpc_btch, bool mpc_warm, bool mpc_adap, double mpc_atol, bool mpc_dead, double mpc_budg,
+    bool srf_used, bool srf_fall
 ) try
   : logging("cntrl"), init(false),
-    aer_dat(aer_path), atm_dat(atm_path),
+    aer_tab(aer_path), atm_dat(atm_path),
     env_grvty(env_grvty), env_gcnst(env_gcnst), env_molar(env_molar), env_gamma(env_gamma),
     vhc_mass(vhc_mass), vhc_iner(vhc_iner), vhc_cmas(vhc_cmas), vhc_area(vhc_area),
-    mpc_apog(mpc_apog), mpc_enab(mpc_enab), mpc_step(mpc_step), mpc_phrz(mpc_phrz), mpc_thrz(mpc_thrz), mpc_tol(mpc_tol) {
+    mpc_apog(mpc_apog), mpc_enab(mpc_enab), mpc_step(mpc_step), mpc_phrz(mpc_phrz), mpc_thrz(mpc_thrz), mpc_tol(mpc_tol),
+    mpc_wrkr(mpc_wrkr), mpc_btch(mpc_btch), mpc_warm(mpc_warm), mpc_adap(mpc_adap), mpc_atol(mpc_atol),
+    mpc_dead(mpc_dead), mpc_budg(mpc_budg), srf_used(srf_used), srf_fall(srf_fall),
+    warm_ctrl(0), warm_used(false), eval_count(0), eval_conv(true), eval_dead(std::chrono::steady_clock::time_point::max()),
+    wrkr_estm(nullptr), wrkr_size(0), wrkr_round(0), wrkr_pend(0), wrkr_stop(false) {
 
     this->logging.inf(
         "Initializing instance: ",
-        "Aer path: ", aer_path, ", Atm path: ", atm_path, ", ",
+        "Aer path: ", aer_path, ", Atm path: ", atm_path, ", Srf path: ", srf_path, ", ",
         "Gravity: ", this->env_grvty, ", Gas const: ", this->env_gcnst, ", Mol mass: ", this->env_molar, ", Gamma: ", this->env_gamma, ", ",
         "Mass: ", this->vhc_mass, ", Iner: ", this->vhc_iner, ", Cent mass: ", this->vhc_cmas, ", Cross sect area: ", this->vhc_area, ", ",
         "Apog altd: ", this->mpc_apog, ", Enab altd: ", this->mpc_enab, ", Time step: ", this->mpc_step, ", ",
-        "Pred horz: ", this->mpc_phrz, ", Term horz: ", this->mpc_thrz, ", Tol: ", this->mpc_tol
+        "Pred horz: ", this->mpc_phrz, ", Term horz: ", this->mpc_thrz, ", Tol: ", this->mpc_tol, ", Workers: ", this->mpc_wrkr, ", Batch: ", this->mpc_btch, ", Warm start: ", this->mpc_warm, ", ",
+        "Adap step: ", this->mpc_adap, ", Adap tol: ", this->mpc_atol, ", ",
+        "Deadline: ", this->mpc_dead, ", Budget: ", this->mpc_budg, ", ",
+        "Srf used: ", this->srf_used, ", Srf fallback: ", this->srf_fall
     );
 
     if (!instance::instantiate()) {
@@ -119,23 +155,56 @@ instance::instance (
         throw except_ctor::fail;
     }
 
+    if (this->mpc_atol <= 0) {
+        this->logging.err("Failed to initialize instance (Invalid adaptive tolerance)");
+        throw except_ctor::fail;
+    }
+
+    if (this->mpc_budg <= 0) {
+        this->logging.err("Failed to initialize instance (Invalid compute budget)");
+        throw except_ctor::fail;
+    }
+
+    if (this->mpc_wrkr < 1) {
+        this->logging.err("Failed to initialize instance (Invalid worker count)");
+        throw except_ctor::fail;
+    }
+
+    if (this->mpc_btch < 1 || 2 * this->mpc_btch > btch::size) {
+        this->logging.err("Failed to initialize instance (Invalid batch size)");
+        throw except_ctor::fail;
+    }
+
     try {
-        this->aer_load();
         this->atm_load();
+        if (this->srf_used) {
+            this->srf_load(srf_path);
+        }
+        this->wrkr_start();
     } catch (...) {
         this->logging.err("Failed to initialize instance");
         throw except_ctor::fail;
     }
 
     this->init = true;
+} catch (aertab::instance::except_ctor) {
+    throw except_ctor::fail;
 } catch (csvread::instance::except_ctor) {
     throw except_ctor::fail;
 }
 
+instance::~instance (void) {
+    if (this->init) {
+        this->wrkr_halt();
+    }
+}
+
 double instance::get_ctrl (const linalg::fvector & estm) {
     double ctrl;
-    double ctrl_min = 0, ctrl_mid = 0.5, ctrl_max = 1;
-    int categ_min, categ_mid, categ_max;
+    double ctrl_min = 0, ctrl_max = 1, ctrl_wdth = 1, ctrl_next;
+    int categ_min, categ_max, categ_prev;
+    int size = this->mpc_wrkr * this->mpc_btch;
+    bool mono, late = false;
 
     this->logging.inf("Getting control signal: Estm: ", estm);
 
@@ -144,6 +213,12 @@ double instance::get_ctrl (const linalg::fvector & estm) {
         throw except_get_ctrl::fail;
     }
 
+    this->eval_count = 0;
+    this->eval_conv = true;
+
+    auto time_strt = std::chrono::steady_clock::now();
+    this->eval_dead = time_strt + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(this->mpc_budg));
+
     if (linalg::dim(estm) != 4) {
         this->logging.err("Failed to get control signal (Invalid estimate vector)");
         throw except_get_ctrl::fail;
@@ -162,372 +237,215 @@ double instance::get_ctrl (const linalg::fvector & estm) {
         ctrl = 1;
     } else {
         try {
-            this->comp_categ(ctrl_min, estm, categ_min);
-            this->comp_categ(ctrl_max, estm, categ_max);
+            if (this->mpc_warm && this->warm_used) {
+                ctrl_wdth = this->mpc_tol;
+                ctrl_min = std::max(this->warm_ctrl - ctrl_wdth, 0.0);
+                ctrl_max = std::min(this->warm_ctrl + ctrl_wdth, 1.0);
+            }
 
-            while (ctrl_max - ctrl_min > this->mpc_tol) {
-                ctrl_mid = 0.5 * (ctrl_min + ctrl_max);
-                this->comp_categ(ctrl_mid, estm, categ_mid);
+            this->cand_dat[0].ctrl = ctrl_min;
+            this->cand_dat[1].ctrl = ctrl_max;
+
+            if (!this->wrkr_eval(estm, 2)) {
+                // No bracket evaluated in time: hold the last control signal, or keep the brake retracted
+                this->eval_conv = false;
+                ctrl = (this->warm_used) ? this->warm_ctrl : 0;
+            } else {
+                categ_min = this->cand_dat[0].categ;
+                categ_max = this->cand_dat[1].categ;
+
+                while ((categ_min != 1 && ctrl_min > 0) || (categ_max == 1 && ctrl_max < 1)) {
+                    if (this->mpc_dead && std::chrono::steady_clock::now() >= this->eval_dead) {
+                        late = true;
+                        break;
+                    }
+
+                    if (categ_min != 1 && ctrl_min > 0) {
+                        ctrl_next = std::max(ctrl_min - 2 * ctrl_wdth, 0.0);
+
+                        this->cand_dat[0].ctrl = ctrl_next;
+                        if (!this->wrkr_eval(estm, 1)) {
+                            late = true;
+                            break;
+                        }
+
+                        ctrl_max = ctrl_min;
+                        categ_max = categ_min;
+                        ctrl_min = ctrl_next;
+                        categ_min = this->cand_dat[0].categ;
+                    } else if (categ_max == 1 && ctrl_max < 1) {
+                        ctrl_next = std::min(ctrl_max + 2 * ctrl_wdth, 1.0);
+
+                        this->cand_dat[0].ctrl = ctrl_next;
+                        if (!this->wrkr_eval(estm, 1)) {
+                            late = true;
+                            break;
+                        }
+
+                        ctrl_min = ctrl_max;
+                        categ_min = categ_max;
+                        ctrl_max = ctrl_next;
+                        categ_max = this->cand_dat[0].categ;
+                    }
+
+                    ctrl_wdth *= 2;
+                }
 
-                if (categ_min == 1 && categ_mid == 1 && categ_max == 1) {
-                    ctrl_min = ctrl_max;
-                    categ_min = categ_max;
-                } else if (categ_min == 1 && categ_mid == 1 && categ_max == 0) {
-                    ctrl_min = ctrl_mid;
-                    categ_min = categ_mid;
-                } else if (categ_min == 1 && categ_mid == 1 && categ_max == -1) {
-                    ctrl_min = ctrl_mid;
-                    categ_min = categ_mid;
-                } else if (categ_min == 1 && categ_mid == 0 && categ_max == 0) {
-                    ctrl_max = ctrl_mid;
-                    categ_max = categ_mid;
-                } else if (categ_min == 1 && categ_mid == 0 && categ_max == -1) {
-                    ctrl_max = ctrl_mid;
-                    categ_max = categ_mid;
-                } else if (categ_min == 1 && categ_mid == -1 && categ_max == -1) {
-                    ctrl_max = ctrl_mid;
-                    categ_max = categ_mid;
-                } else if (categ_min == 0 && categ_mid == 0 && categ_max == 0) {
-                    ctrl_max = ctrl_min;
-                    categ_max = categ_min;
-                } else if (categ_min == 0 && categ_mid == 0 && categ_max == -1) {
+                if (categ_min != 1) {
                     ctrl_max = ctrl_min;
                     categ_max = categ_min;
-                } else if (categ_min == 0 && categ_mid == -1 && categ_max == -1) {
-                    ctrl_max = ctrl_min;
-                    categ_max = categ_min;
-                } else if (categ_min == -1 && categ_mid == -1 && categ_max == -1) {
-                    ctrl_max = ctrl_min;
-                    categ_max = categ_min;
-                } else {
-                    ctrl_min = 0;
-                    ctrl_max = 0;
+                } else if (categ_max == 1) {
+                    ctrl_min = ctrl_max;
+                    categ_min = categ_max;
+                }
+
+                while (!late && ctrl_max - ctrl_min > this->mpc_tol) {
+                    if (this->mpc_dead && std::chrono::steady_clock::now() >= this->eval_dead) {
+                        late = true;
+                        break;
+                    }
+
+                    for (int i = 0; i < size; i++) {
+                        this->cand_dat[i].ctrl = ctrl_min + (i + 1) * (ctrl_max - ctrl_min) / (size + 1);
+                    }
+
+                    if (!this->wrkr_eval(estm, size)) {
+                        late = true;
+                        break;
+                    }
+
+                    mono = true;
+                    categ_prev = categ_min;
+                    for (int i = 0; i < size; i++) {
+                        if (this->cand_dat[i].categ > categ_prev) {
+                            mono = false;
+                        }
+                        categ_prev = this->cand_dat[i].categ;
+                    }
+                    if (categ_max > categ_prev) {
+                        mono = false;
+                    }
+
+                    if (!mono) {
+                        ctrl_min = 0;
+                        ctrl_max = 0;
+                    } else if (categ_min != 1) {
+                        ctrl_max = ctrl_min;
+                        categ_max = categ_min;
+                    } else if (categ_max == 1) {
+                        ctrl_min = ctrl_max;
+                        categ_min = categ_max;
+                    } else {
+                        for (int i = 0; i < size; i++) {
+                            if (this->cand_dat[i].categ == 1) {
+                                ctrl_min = this->cand_dat[i].ctrl;
+                            } else {
+                                ctrl_max = this->cand_dat[i].ctrl;
+                                categ_max = this->cand_dat[i].categ;
+                                break;
+                            }
+                        }
+                    }
                 }
-            }
 
-            ctrl = 0.5 * (ctrl_min + ctrl_max);
+                if (late) {
+                    this->eval_conv = false;
+                }
+
+                ctrl = 0.5 * (ctrl_min + ctrl_max);
+            }
         } catch (...) {
+            this->warm_used = false;
             this->logging.err("Failed to get control signal (Computation limit exceeded)");
             throw except_get_ctrl::fail;
         }
     }
 
-    this->logging.inf("Got control signal: ", ctrl);
+    this->warm_ctrl = ctrl;
+    this->warm_used = true;
+
+    this->logging.inf("Got control signal: ", ctrl, ", Evaluations: ", this->eval_count, ", Converged: ", this->eval_conv);
 
     return ctrl;
 }
 
-void instance::aer_load (void) {
-    std::vector<std::string> head;
-    std::vector<double> body;
-    std::vector<std::vector<double>> data;
-    std::vector<std::vector<std::vector<bool>>> covered;
-    double attk, mach, brak, lift, drag, cprs;
-    int attk_col, mach_col, brak_col, lift_col, drag_col, cprs_col;
-    int attk_idx, mach_idx, brak_idx;
-
-    this->logging.inf("Creating aerodynamic lookup table");
+int instance::get_eval (void) {
+    this->logging.inf("Getting evaluation count");
 
-    try {
-        head = this->aer_dat.get_head();
-    } catch (...) {
-        this->logging.err("Failed to create aerodynamic lookup table");
-        throw except_aer_load::fail;
+    if (!this->init) {
+        this->logging.err("Failed to get evaluation count (Instance not initialized)");
+        throw except_get_eval::fail;
     }
 
-    attk_col = std::distance(head.begin(), std::find(head.begin(), head.end(), "Angle of attack (rad)"));
-    mach_col = std::distance(head.begin(), std::find(head.begin(), head.end(), "Mach number"));
-    brak_col = std::distance(head.begin(), std::find(head.begin(), head.end(), "Brake deployment"));
-    lift_col = std::distance(head.begin(), std::find(head.begin(), head.end(), "Lift coefficient"));
-    drag_col = std::distance(head.begin(), std::find(head.begin(), head.end(), "Drag coefficient"));
-    cprs_col = std::distance(head.begin(), std::find(head.begin(), head.end(), "Center of pressure (m)"));
+    this->logging.inf("Got evaluation count: ", this->eval_count);
 
-    if (
-           attk_col == int(head.size()) || mach_col == int(head.size()) || brak_col == int(head.size())
-        || lift_col == int(head.size()) || drag_col == int(head.size()) || cprs_col == int(head.size())
-    ) {
-        this->logging.err("Failed to create aerodynamic lookup table (Missing column)");
-        throw except_aer_load::fail;
-    }
-
-    try {
-        while (true) {
-            body = this->aer_dat.get_body();
+    return this->eval_count;
+}
 
-            attk = body[attk_col];
-            mach = body[mach_col];
-            brak = body[brak_col];
-            lift = body[lift_col];
-            drag = body[drag_col];
-            cprs = body[cprs_col];
+bool instance::get_conv (void) {
+    this->logging.inf("Getting convergence flag");
 
-            data.push_back({attk, mach, brak, lift, drag, cprs});
-        }
-    } catch (csvread::instance::except_get_body except) {
-        switch (except) {
-            case csvread::instance::except_get_body::fail:
-                this->logging.err("Failed to create aerodynamic lookup table");
-                throw except_aer_load::fail;
-            case csvread::instance::except_get_body::eof:
-                break;
-        }
-    }
-
-    for (auto itr = data.begin(); itr < data.end(); itr++) {
-        if (!std::binary_search(this->aer_attk.begin(), this->aer_attk.end(), (*itr)[0])) {
-            this->aer_attk.insert(std::lower_bound(this->aer_attk.begin(), this->aer_attk.end(), (*itr)[0]), (*itr)[0]);
-        }
-        if (!std::binary_search(this->aer_mach.begin(), this->aer_mach.end(), (*itr)[1])) {
-            this->aer_mach.insert(std::lower_bound(this->aer_mach.begin(), this->aer_mach.end(), (*itr)[1]), (*itr)[1]);
-        }
-        if (!std::binary_search(this->aer_brak.begin(), this->aer_brak.end(), (*itr)[2])) {
-            this->aer_brak.insert(std::lower_bound(this->aer_brak.begin(), this->aer_brak.end(), (*itr)[2]), (*itr)[2]);
-        }
+    if (!this->init) {
+        this->logging.err("Failed to get convergence flag (Instance not initialized)");
+        throw except_get_conv::fail;
     }
 
-    if (this->aer_attk.size() < 2 || this->aer_mach.size() < 2 || this->aer_brak.size() < 2) {
-        this->logging.err("Failed to create aerodynamic lookup table (Insufficient data)");
-        throw except_aer_load::fail;
-    }
+    this->logging.inf("Got convergence flag: ", this->eval_conv);
 
-    this->aer_lift = std::vector<std::vector<std::vector<double>>>(
-        this->aer_attk.size(), std::vector<std::vector<double>>(
-            this->aer_mach.size(), std::vector<double>(
-                this->aer_brak.size()
-            )
-        )
-    );
+    return this->eval_conv;
+}
 
-    this->aer_drag = std::vector<std::vector<std::vector<double>>>(
-        this->aer_attk.size(), std::vector<std::vector<double>>(
-            this->aer_mach.size(), std::vector<double>(
-                this->aer_brak.size()
-            )
-        )
-    );
+double instance::get_apog (double ctrl, const linalg::fvector & estm) {
+    return this->get_apog(ctrl, estm, 0);
+}
 
-    this->aer_cprs = std::vector<std::vector<std::vector<double>>>(
-        this->aer_attk.size(), std::vector<std::vector<double>>(
-            this->aer_mach.size(), std::vector<double>(
-                this->aer_brak.size()
-            )
-        )
-    );
+double instance::get_apog (double ctrl, const linalg::fvector & estm, double attk) {
+    std::array<double, 6> stat, term;
+    double apog;
 
-    covered = std::vector<std::vector<std::vector<bool>>>(
-        this->aer_attk.size(), std::vector<std::vector<bool>>(
-            this->aer_mach.size(), std::vector<bool>(
-                this->aer_brak.size(), false
-            )
-        )
-    );
+    this->logging.inf("Getting apogee altitude: Ctrl: ", ctrl, ", Estm: ", estm, ", Attk: ", attk);
 
-    for (auto itr = data.begin(); itr < data.end(); itr++) {
-        attk_idx = std::distance(this->aer_attk.begin(), std::find(this->aer_attk.begin(), this->aer_attk.end(), (*itr)[0]));
-        mach_idx = std::distance(this->aer_mach.begin(), std::find(this->aer_mach.begin(), this->aer_mach.end(), (*itr)[1]));
-        brak_idx = std::distance(this->aer_brak.begin(), std::find(this->aer_brak.begin(), this->aer_brak.end(), (*itr)[2]));
+    if (!this->init) {
+        this->logging.err("Failed to get apogee altitude (Instance not initialized)");
+        throw except_get_apog::fail;
+    }
 
-        if (covered[attk_idx][mach_idx][brak_idx]) {
-            this->logging.err("Failed to create aerodynamic lookup table (Repeated data point)");
-            throw except_aer_load::fail;
-        }
+    if (ctrl < 0 || ctrl > 1) {
+        this->logging.err("Failed to get apogee altitude (Invalid control signal)");
+        throw except_get_apog::fail;
+    }
 
-        this->aer_lift[attk_idx][mach_idx][brak_idx] = (*itr)[3];
-        this->aer_drag[attk_idx][mach_idx][brak_idx] = (*itr)[4];
-        this->aer_cprs[attk_idx][mach_idx][brak_idx] = (*itr)[5];
+    if (linalg::dim(estm) != 4) {
+        this->logging.err("Failed to get apogee altitude (Invalid estimate vector)");
+        throw except_get_apog::fail;
+    }
 
-        covered[attk_idx][mach_idx][brak_idx] = true;
+    if (estm[1] < 0 || estm[1] > M_PI) {
+        this->logging.err("Failed to get apogee altitude (Invalid estimate vector)");
+        throw except_get_apog::fail;
     }
 
-    for (auto elem1 : covered) {
-        for (auto elem2 : elem1) {
-            for (auto elem3 : elem2) {
-                if (!elem3) {
-                    this->logging.err("Failed to create aerodynamic lookup table (Missing data point)");
-                    throw except_aer_load::fail;
-                }
-            }
-        }
+    if (attk <= -M_PI / 2 || attk >= M_PI / 2) {
+        this->logging.err("Failed to get apogee altitude (Invalid angle of attack)");
+        throw except_get_apog::fail;
     }
-}
 
-void instance::aer_find (double attk, double mach, double brak, double & lift, double & drag, double & cprs) {
-    int attk_idx1, attk_idx2, mach_idx1, mach_idx2, brak_idx1, brak_idx2;
-    double attk_mean, mach_mean, brak_mean, attk_diff, mach_diff, brak_diff;
-    double lift_mean, lift_grad_attk, lift_grad_mach, lift_grad_brak;
-    double drag_mean, drag_grad_attk, drag_grad_mach, drag_grad_brak;
-    double cprs_mean, cprs_grad_attk, cprs_grad_mach, cprs_grad_brak;
+    this->comp_stat(estm, attk, stat);
 
-    if (attk < this->aer_attk.front()) {
-        attk_idx1 = 0;
-    } else if (attk >= this->aer_attk.back()) {
-        attk_idx1 = this->aer_attk.size() - 2;
-    } else {
-        attk_idx1 = std::distance(this->aer_attk.begin(), std::upper_bound(this->aer_attk.begin(), this->aer_attk.end(), attk)) - 1;
-    }
-    attk_idx2 = attk_idx1 + 1;
+    this->eval_dead = std::chrono::steady_clock::time_point::max();
 
-    if (mach < this->aer_mach.front()) {
-        mach_idx1 = 0;
-    } else if (mach >= this->aer_mach.back()) {
-        mach_idx1 = this->aer_mach.size() - 2;
-    } else {
-        mach_idx1 = std::distance(this->aer_mach.begin(), std::upper_bound(this->aer_mach.begin(), this->aer_mach.end(), mach)) - 1;
+    try {
+        this->comp_term(this->wrkr_dat[0], ctrl, stat, term);
+    } catch (...) {
+        this->logging.err("Failed to get apogee altitude (Computation limit exceeded)");
+        throw except_get_apog::fail;
     }
-    mach_idx2 = mach_idx1 + 1;
 
-    if (brak < this->aer_brak.front()) {
-        brak_idx1 = 0;
-    } else if (brak >= this->aer_brak.back()) {
-        brak_idx1 = this->aer_brak.size() - 2;
-    } else {
-        brak_idx1 = std::distance(this->aer_brak.begin(), std::upper_bound(this->aer_brak.begin(), this->aer_brak.end(), brak)) - 1;
-    }
-    brak_idx2 = brak_idx1 + 1;
-
-    attk_mean = 0.5 * (this->aer_attk[attk_idx1] + this->aer_attk[attk_idx2]);
-    mach_mean = 0.5 * (this->aer_mach[mach_idx1] + this->aer_mach[mach_idx2]);
-    brak_mean = 0.5 * (this->aer_brak[brak_idx1] + this->aer_brak[brak_idx2]);
-
-    attk_diff = attk - attk_mean;
-    mach_diff = mach - mach_mean;
-    brak_diff = brak - brak_mean;
-
-    lift_mean = 0.125 * (
-        + this->aer_lift[attk_idx1][mach_idx1][brak_idx1]
-        + this->aer_lift[attk_idx1][mach_idx1][brak_idx2]
-        + this->aer_lift[attk_idx1][mach_idx2][brak_idx1]
-        + this->aer_lift[attk_idx1][mach_idx2][brak_idx2]
-        + this->aer_lift[attk_idx2][mach_idx1][brak_idx1]
-        + this->aer_lift[attk_idx2][mach_idx1][brak_idx2]
-        + this->aer_lift[attk_idx2][mach_idx2][brak_idx1]
-        + this->aer_lift[attk_idx2][mach_idx2][brak_idx2]
-    );
-
-    lift_grad_attk = 0.25 * (
-        - this->aer_lift[attk_idx1][mach_idx1][brak_idx1]
-        - this->aer_lift[attk_idx1][mach_idx1][brak_idx2]
-        - this->aer_lift[attk_idx1][mach_idx2][brak_idx1]
-        - this->aer_lift[attk_idx1][mach_idx2][brak_idx2]
-        + this->aer_lift[attk_idx2][mach_idx1][brak_idx1]
-        + this->aer_lift[attk_idx2][mach_idx1][brak_idx2]
-        + this->aer_lift[attk_idx2][mach_idx2][brak_idx1]
-        + this->aer_lift[attk_idx2][mach_idx2][brak_idx2]
-    ) / (this->aer_attk[attk_idx2] - this->aer_attk[attk_idx1]);
-
-    lift_grad_mach = 0.25 * (
-        - this->aer_lift[attk_idx1][mach_idx1][brak_idx1]
-        - this->aer_lift[attk_idx1][mach_idx1][brak_idx2]
-        + this->aer_lift[attk_idx1][mach_idx2][brak_idx1]
-        + this->aer_lift[attk_idx1][mach_idx2][brak_idx2]
-        - this->aer_lift[attk_idx2][mach_idx1][brak_idx1]
-        - this->aer_lift[attk_idx2][mach_idx1][brak_idx2]
-        + this->aer_lift[attk_idx2][mach_idx2][brak_idx1]
-        + this->aer_lift[attk_idx2][mach_idx2][brak_idx2]
-    ) / (this->aer_mach[mach_idx2] - this->aer_mach[mach_idx1]);
-
-    lift_grad_brak = 0.25 * (
-        - this->aer_lift[attk_idx1][mach_idx1][brak_idx1]
-        + this->aer_lift[attk_idx1][mach_idx1][brak_idx2]
-        - this->aer_lift[attk_idx1][mach_idx2][brak_idx1]
-        + this->aer_lift[attk_idx1][mach_idx2][brak_idx2]
-        - this->aer_lift[attk_idx2][mach_idx1][brak_idx1]
-        + this->aer_lift[attk_idx2][mach_idx1][brak_idx2]
-        - this->aer_lift[attk_idx2][mach_idx2][brak_idx1]
-        + this->aer_lift[attk_idx2][mach_idx2][brak_idx2]
-    ) / (this->aer_brak[brak_idx2] - this->aer_brak[brak_idx1]);
-
-    drag_mean = 0.125 * (
-        + this->aer_drag[attk_idx1][mach_idx1][brak_idx1]
-        + this->aer_drag[attk_idx1][mach_idx1][brak_idx2]
-        + this->aer_drag[attk_idx1][mach_idx2][brak_idx1]
-        + this->aer_drag[attk_idx1][mach_idx2][brak_idx2]
-        + this->aer_drag[attk_idx2][mach_idx1][brak_idx1]
-        + this->aer_drag[attk_idx2][mach_idx1][brak_idx2]
-        + this->aer_drag[attk_idx2][mach_idx2][brak_idx1]
-        + this->aer_drag[attk_idx2][mach_idx2][brak_idx2]
-    );
+    apog = term[0];
 
-    drag_grad_attk = 0.25 * (
-        - this->aer_drag[attk_idx1][mach_idx1][brak_idx1]
-        - this->aer_drag[attk_idx1][mach_idx1][brak_idx2]
-        - this->aer_drag[attk_idx1][mach_idx2][brak_idx1]
-        - this->aer_drag[attk_idx1][mach_idx2][brak_idx2]
-        + this->aer_drag[attk_idx2][mach_idx1][brak_idx1]
-        + this->aer_drag[attk_idx2][mach_idx1][brak_idx2]
-        + this->aer_drag[attk_idx2][mach_idx2][brak_idx1]
-        + this->aer_drag[attk_idx2][mach_idx2][brak_idx2]
-    ) / (this->aer_attk[attk_idx2] - this->aer_attk[attk_idx1]);
-
-    drag_grad_mach = 0.25 * (
-        - this->aer_drag[attk_idx1][mach_idx1][brak_idx1]
-        - this->aer_drag[attk_idx1][mach_idx1][brak_idx2]
-        + this->aer_drag[attk_idx1][mach_idx2][brak_idx1]
-        + this->aer_drag[attk_idx1][mach_idx2][brak_idx2]
-        - this->aer_drag[attk_idx2][mach_idx1][brak_idx1]
-        - this->aer_drag[attk_idx2][mach_idx1][brak_idx2]
-        + this->aer_drag[attk_idx2][mach_idx2][brak_idx1]
-        + this->aer_drag[attk_idx2][mach_idx2][brak_idx2]
-    ) / (this->aer_mach[mach_idx2] - this->aer_mach[mach_idx1]);
-
-    drag_grad_brak = 0.25 * (
-        - this->aer_drag[attk_idx1][mach_idx1][brak_idx1]
-        + this->aer_drag[attk_idx1][mach_idx1][brak_idx2]
-        - this->aer_drag[attk_idx1][mach_idx2][brak_idx1]
-        + this->aer_drag[attk_idx1][mach_idx2][brak_idx2]
-        - this->aer_drag[attk_idx2][mach_idx1][brak_idx1]
-        + this->aer_drag[attk_idx2][mach_idx1][brak_idx2]
-        - this->aer_drag[attk_idx2][mach_idx2][brak_idx1]
-        + this->aer_drag[attk_idx2][mach_idx2][brak_idx2]
-    ) / (this->aer_brak[brak_idx2] - this->aer_brak[brak_idx1]);
-
-    cprs_mean = 0.125 * (
-        + this->aer_cprs[attk_idx1][mach_idx1][brak_idx1]
-        + this->aer_cprs[attk_idx1][mach_idx1][brak_idx2]
-        + this->aer_cprs[attk_idx1][mach_idx2][brak_idx1]
-        + this->aer_cprs[attk_idx1][mach_idx2][brak_idx2]
-        + this->aer_cprs[attk_idx2][mach_idx1][brak_idx1]
-        + this->aer_cprs[attk_idx2][mach_idx1][brak_idx2]
-        + this->aer_cprs[attk_idx2][mach_idx2][brak_idx1]
-        + this->aer_cprs[attk_idx2][mach_idx2][brak_idx2]
-    );
+    this->logging.inf("Got apogee altitude: ", apog);
 
-    cprs_grad_attk = 0.25 * (
-        - this->aer_cprs[attk_idx1][mach_idx1][brak_idx1]
-        - this->aer_cprs[attk_idx1][mach_idx1][brak_idx2]
-        - this->aer_cprs[attk_idx1][mach_idx2][brak_idx1]
-        - this->aer_cprs[attk_idx1][mach_idx2][brak_idx2]
-        + this->aer_cprs[attk_idx2][mach_idx1][brak_idx1]
-        + this->aer_cprs[attk_idx2][mach_idx1][brak_idx2]
-        + this->aer_cprs[attk_idx2][mach_idx2][brak_idx1]
-        + this->aer_cprs[attk_idx2][mach_idx2][brak_idx2]
-    ) / (this->aer_attk[attk_idx2] - this->aer_attk[attk_idx1]);
-
-    cprs_grad_mach = 0.25 * (
-        - this->aer_cprs[attk_idx1][mach_idx1][brak_idx1]
-        - this->aer_cprs[attk_idx1][mach_idx1][brak_idx2]
-        + this->aer_cprs[attk_idx1][mach_idx2][brak_idx1]
-        + this->aer_cprs[attk_idx1][mach_idx2][brak_idx2]
-        - this->aer_cprs[attk_idx2][mach_idx1][brak_idx1]
-        - this->aer_cprs[attk_idx2][mach_idx1][brak_idx2]
-        + this->aer_cprs[attk_idx2][mach_idx2][brak_idx1]
-        + this->aer_cprs[attk_idx2][mach_idx2][brak_idx2]
-    ) / (this->aer_mach[mach_idx2] - this->aer_mach[mach_idx1]);
-
-    cprs_grad_brak = 0.25 * (
-        - this->aer_cprs[attk_idx1][mach_idx1][brak_idx1]
-        + this->aer_cprs[attk_idx1][mach_idx1][brak_idx2]
-        - this->aer_cprs[attk_idx1][mach_idx2][brak_idx1]
-        + this->aer_cprs[attk_idx1][mach_idx2][brak_idx2]
-        - this->aer_cprs[attk_idx2][mach_idx1][brak_idx1]
-        + this->aer_cprs[attk_idx2][mach_idx1][brak_idx2]
-        - this->aer_cprs[attk_idx2][mach_idx2][brak_idx1]
-        + this->aer_cprs[attk_idx2][mach_idx2][brak_idx2]
-    ) / (this->aer_brak[brak_idx2] - this->aer_brak[brak_idx1]);
-
-    lift = lift_mean + lift_grad_attk * attk_diff + lift_grad_mach * mach_diff + lift_grad_brak * brak_diff;
-    drag = drag_mean + drag_grad_attk * attk_diff + drag_grad_mach * mach_diff + drag_grad_brak * brak_diff;
-    cprs = cprs_mean + cprs_grad_attk * attk_diff + cprs_grad_mach * mach_diff + cprs_grad_brak * brak_diff;
+    return apog;
 }
 
 void instance::atm_load (void) {
@@ -617,22 +535,18 @@ void instance::atm_load (void) {
             throw except_atm_load::fail;
         }
     }
+
+    this->atm_step = lookup::step(this->atm_altd);
 }
 
-void instance::atm_find (double altd, double & pres, double & temp, double & dens) {
+void instance::atm_find (wrkr & wrkr, double altd, double & pres, double & temp, double & dens) {
     int altd_idx1, altd_idx2;
     double altd_mean, altd_diff;
     double pres_mean, pres_grad_altd;
     double temp_mean, temp_grad_altd;
     double dens_mean, dens_grad_altd;
 
-    if (altd < this->atm_altd.front()) {
-        altd_idx1 = 0;
-    } else if (altd >= this->atm_altd.back()) {
-        altd_idx1 = this->atm_altd.size() - 2;
-    } else {
-        altd_idx1 = std::distance(this->atm_altd.begin(), std::upper_bound(this->atm_altd.begin(), this->atm_altd.end(), altd)) - 1;
-    }
+    altd_idx1 = lookup::find(this->atm_altd, this->atm_step, altd, wrkr.atm_hint);
     altd_idx2 = altd_idx1 + 1;
 
     altd_mean = 0.5 * (this->atm_altd[altd_idx1] + this->atm_altd[altd_idx2]);
@@ -652,7 +566,92 @@ void instance::atm_find (double altd, double & pres, double & temp, double & den
     dens = dens_mean + dens_grad_altd * altd_diff;
 }
 
-void instance::comp_stat (const linalg::fvector & estm, linalg::fvector & stat) {
+void instance::srf_load (const std::string & path) {
+    std::vector<double> lower, upper;
+    std::vector<int> count;
+
+    this->logging.inf("Creating apogee lookup surface");
+
+    try {
+        this->srf_dat.emplace(path);
+        lower = this->srf_dat->get_lower();
+        upper = this->srf_dat->get_upper();
+        count = this->srf_dat->get_count();
+        this->srf_body = this->srf_dat->get_body();
+    } catch (...) {
+        this->logging.err("Failed to create apogee lookup surface");
+        throw except_srf_load::fail;
+    }
+
+    if (lower.size() != 6) {
+        this->logging.err("Failed to create apogee lookup surface (Invalid dimension)");
+        throw except_srf_load::fail;
+    }
+
+    for (int i = 5; i >= 0; i--) {
+        this->srf_lower[i] = lower[i];
+        this->srf_upper[i] = upper[i];
+        this->srf_count[i] = count[i];
+        this->srf_step[i] = (upper[i] - lower[i]) / (count[i] - 1);
+        this->srf_stride[i] = (i == 5) ? 1 : this->srf_stride[i + 1] * this->srf_count[i + 1];
+    }
+
+    if (this->srf_lower[1] < 0 || this->srf_upper[1] > M_PI || this->srf_lower[4] <= -M_PI / 2 || this->srf_upper[4] >= M_PI / 2) {
+        this->logging.err("Failed to create apogee lookup surface (Invalid domain)");
+        throw except_srf_load::fail;
+    }
+
+    if (this->srf_lower[5] < 0 || this->srf_upper[5] > 1) {
+        this->logging.err("Failed to create apogee lookup surface (Invalid domain)");
+        throw except_srf_load::fail;
+    }
+}
+
+bool instance::srf_find (const std::array<double, 6> & stat, double brak, double & apog) {
+    double coord[6] = {stat[0], stat[2], stat[3], stat[5], std::atan2(stat[4], stat[3]) - stat[2], brak};
+    double frac[6], wght;
+    int idx[6], offs;
+
+    for (int i = 0; i < 6; i++) {
+        if (coord[i] < this->srf_lower[i] || coord[i] > this->srf_upper[i]) {
+            return false;
+        }
+
+        frac[i] = (coord[i] - this->srf_lower[i]) / this->srf_step[i];
+        idx[i] = int(frac[i]);
+        if (idx[i] > this->srf_count[i] - 2) {
+            idx[i] = this->srf_count[i] - 2;
+        }
+        frac[i] -= idx[i];
+    }
+
+    apog = 0;
+
+    for (int corn = 0; corn < 64; corn++) {
+        wght = 1;
+        offs = 0;
+        for (int i = 0; i < 6; i++) {
+            if (corn & (32 >> i)) {
+                wght *= frac[i];
+                offs += (idx[i] + 1) * this->srf_stride[i];
+            } else {
+                wght *= 1 - frac[i];
+                offs += idx[i] * this->srf_stride[i];
+            }
+        }
+        apog += wght * this->srf_body[offs];
+    }
+
+    return true;
+}
+
+void instance::comp_dead (void) {
+    if (this->mpc_dead && std::chrono::steady_clock::now() >= this->eval_dead) {
+        throw except_comp_dead::late;
+    }
+}
+
+void instance::comp_stat (const linalg::fvector & estm, double attk, std::array<double, 6> & stat) {
     double pos_ver, pos_hor, pos_ang, vel_ver, vel_hor, vel_ang;
 
     pos_ver = estm[0];
@@ -661,12 +660,12 @@ void instance::comp_stat (const linalg::fvector & estm, linalg::fvector & stat)
     vel_ang = estm[3];
 
     pos_hor = 0;
-    vel_hor = vel_ver * std::tan(pos_ang);
+    vel_hor = vel_ver * std::tan(pos_ang + attk);
 
     stat = {pos_ver, pos_hor, pos_ang, vel_ver, vel_hor, vel_ang};
 }
 
-void instance::comp_derv (double ctrl, const linalg::fvector & stat, linalg::fvector & derv) {
+void instance::comp_derv (wrkr & wrkr, double ctrl, const std::array<double, 6> & stat, std::array<double, 6> & derv) {
     double pos_ver, pos_ang, vel_ver, vel_hor, vel_ang, acc_ver, acc_hor, acc_ang;
     double attk, mach, brak, lift, drag, cprs, altd, pres, temp, dens;
     double vel_par, vel_per, vel_tot, vel_snd;
@@ -681,7 +680,7 @@ void instance::comp_derv (double ctrl, const linalg::fvector & stat, linalg::fve
 
     if (vel_ver > 0) {
         altd = pos_ver;
-        this->atm_find(altd, pres, temp, dens);
+        this->atm_find(wrkr, altd, pres, temp, dens);
 
         cos_pos_ang = std::cos(pos_ang);
         sin_pos_ang = std::sin(pos_ang);
@@ -694,7 +693,7 @@ void instance::comp_derv (double ctrl, const linalg::fvector & stat, linalg::fve
         attk = std::atan2(vel_per, vel_par);
         mach = vel_tot / vel_snd;
         brak = ctrl;
-        this->aer_find(attk, mach, brak, lift, drag, cprs);
+        this->aer_tab.find(attk, mach, brak, lift, drag, cprs, wrkr.aer_hint);
 
         forc_wght = this->vhc_mass * this->env_grvty;
         forc_lift = 0.5 * dens * vel_tot * vel_tot * this->vhc_area * lift * attk;
@@ -715,19 +714,41 @@ void instance::comp_derv (double ctrl, const linalg::fvector & stat, linalg::fve
     derv = {vel_ver, vel_hor, vel_ang, acc_ver, acc_hor, acc_ang};
 }
 
-void instance::comp_pred (double ctrl, const linalg::fvector & stat, linalg::fvector & pred) {
-    linalg::fvector runge_kutta_k1, runge_kutta_k2, runge_kutta_k3, runge_kutta_k4;
+void instance::comp_pred (wrkr & wrkr, double ctrl, const std::array<double, 6> & stat, std::array<double, 6> & pred) {
+    std::array<double, 6> runge_kutta_k1, runge_kutta_k2, runge_kutta_k3, runge_kutta_k4, runge_kutta_arg, runge_kutta_prev;
     int count = 0;
 
     pred = stat;
 
     while (this->mpc_phrz > count * this->mpc_step && pred[3] > 0) { 
-        this->comp_derv(ctrl, pred, runge_kutta_k1);
-        this->comp_derv(ctrl, pred + runge_kutta_k1 * this->mpc_step / 2, runge_kutta_k2);
-        this->comp_derv(ctrl, pred + runge_kutta_k2 * this->mpc_step / 2, runge_kutta_k3);
-        this->comp_derv(ctrl, pred + runge_kutta_k3 * this->mpc_step, runge_kutta_k4);
+        this->comp_dead();
+
+        this->comp_derv(wrkr, ctrl, pred, runge_kutta_k1);
 
-        pred += (runge_kutta_k1 + 2 * runge_kutta_k2 + 2 * runge_kutta_k3 + runge_kutta_k4) * this->mpc_step / 6; 
+        for (int i = 0; i < 6; i++) {
+            runge_kutta_arg[i] = pred[i] + runge_kutta_k1[i] * this->mpc_step / 2;
+        }
+        this->comp_derv(wrkr, ctrl, runge_kutta_arg, runge_kutta_k2);
+
+        for (int i = 0; i < 6; i++) {
+            runge_kutta_arg[i] = pred[i] + runge_kutta_k2[i] * this->mpc_step / 2;
+        }
+        this->comp_derv(wrkr, ctrl, runge_kutta_arg, runge_kutta_k3);
+
+        for (int i = 0; i < 6; i++) {
+            runge_kutta_arg[i] = pred[i] + runge_kutta_k3[i] * this->mpc_step;
+        }
+        this->comp_derv(wrkr, ctrl, runge_kutta_arg, runge_kutta_k4);
+
+        runge_kutta_prev = pred;
+
+        for (int i = 0; i < 6; i++) {
+            pred[i] += (runge_kutta_k1[i] + 2 * runge_kutta_k2[i] + 2 * runge_kutta_k3[i] + runge_kutta_k4[i]) * this->mpc_step / 6;
+        }
+
+        if (pred[3] <= 0) {
+            this->comp_apex(runge_kutta_prev, pred, this->mpc_step, pred);
+        }
 
         while (pred[2] < -M_PI) {
             pred[2] += 2 * M_PI;
@@ -741,19 +762,46 @@ void instance::comp_pred (double ctrl, const linalg::fvector & stat, linalg::fve
     }
 }
 
-void instance::comp_term (double ctrl, const linalg::fvector & pred, linalg::fvector & term) {
-    linalg::fvector runge_kutta_k1, runge_kutta_k2, runge_kutta_k3, runge_kutta_k4;
+void instance::comp_term (wrkr & wrkr, double ctrl, const std::array<double, 6> & pred, std::array<double, 6> & term) {
+    std::array<double, 6> runge_kutta_k1, runge_kutta_k2, runge_kutta_k3, runge_kutta_k4, runge_kutta_arg, runge_kutta_prev;
     int count = 0;
 
+    if (this->mpc_adap) {
+        this->comp_adap(wrkr, ctrl, pred, term);
+        return;
+    }
+
     term = pred;
 
     while (term[3] > 0) {
-        this->comp_derv(ctrl, term, runge_kutta_k1);
-        this->comp_derv(ctrl, term + runge_kutta_k1 * this->mpc_step / 2, runge_kutta_k2);
-        this->comp_derv(ctrl, term + runge_kutta_k2 * this->mpc_step / 2, runge_kutta_k3);
-        this->comp_derv(ctrl, term + runge_kutta_k3 * this->mpc_step, runge_kutta_k4);
+        this->comp_dead();
+
+        this->comp_derv(wrkr, ctrl, term, runge_kutta_k1);
+
+        for (int i = 0; i < 6; i++) {
+            runge_kutta_arg[i] = term[i] + runge_kutta_k1[i] * this->mpc_step / 2;
+        }
+        this->comp_derv(wrkr, ctrl, runge_kutta_arg, runge_kutta_k2);
+
+        for (int i = 0; i < 6; i++) {
+            runge_kutta_arg[i] = term[i] + runge_kutta_k2[i] * this->mpc_step / 2;
+        }
+        this->comp_derv(wrkr, ctrl, runge_kutta_arg, runge_kutta_k3);
+
+        for (int i = 0; i < 6; i++) {
+            runge_kutta_arg[i] = term[i] + runge_kutta_k3[i] * this->mpc_step;
+        }
+        this->comp_derv(wrkr, ctrl, runge_kutta_arg, runge_kutta_k4);
 
-        term += (runge_kutta_k1 + 2 * runge_kutta_k2 + 2 * runge_kutta_k3 + runge_kutta_k4) * this->mpc_step / 6;
+        runge_kutta_prev = term;
+
+        for (int i = 0; i < 6; i++) {
+            term[i] += (runge_kutta_k1[i] + 2 * runge_kutta_k2[i] + 2 * runge_kutta_k3[i] + runge_kutta_k4[i]) * this->mpc_step / 6;
+        }
+
+        if (term[3] <= 0) {
+            this->comp_apex(runge_kutta_prev, term, this->mpc_step, term);
+        }
 
         while (term[2] < -M_PI) {
             term[2] += 2 * M_PI;
@@ -771,30 +819,149 @@ void instance::comp_term (double ctrl, const linalg::fvector & pred, linalg::fve
     }
 }
 
-void instance::comp_categ (double ctrl, const linalg::fvector & estm, int & categ) {
-    linalg::fvector stat, pred, term;
+void instance::comp_adap (wrkr & wrkr, double ctrl, const std::array<double, 6> & pred, std::array<double, 6> & term) {
+    std::array<double, 6> dopr_k[7], dopr_arg;
+    double time = 0, step = this->mpc_step, diff, err, fact;
+    int count = 0;
+
+    term = pred;
+
+    this->comp_derv(wrkr, ctrl, term, dopr_k[0]);
+
+    while (term[3] > 0) {
+        this->comp_dead();
+
+        count++;
+
+        if (this->mpc_thrz <= time || this->mpc_thrz <= count * this->mpc_step) {
+            throw except_comp_term::fail;
+        }
+
+        for (int j = 1; j < 7; j++) {
+            for (int i = 0; i < 6; i++) {
+                dopr_arg[i] = term[i];
+                for (int l = 0; l < j; l++) {
+                    dopr_arg[i] += step * intern::dopr_a[j][l] * dopr_k[l][i];
+                }
+            }
+            this->comp_derv(wrkr, ctrl, dopr_arg, dopr_k[j]);
+        }
+
+        err = 0;
+        for (int i = 0; i < 6; i++) {
+            diff = 0;
+            for (int l = 0; l < 7; l++) {
+                diff += step * intern::dopr_e[l] * dopr_k[l][i];
+            }
+            err = std::max(err, std::fabs(diff) / (this->mpc_atol * (1 + std::max(std::fabs(term[i]), std::fabs(dopr_arg[i])))));
+        }
+
+        if (err <= 1 || step <= this->mpc_step) {
+            if (dopr_arg[3] <= 0) {
+                this->comp_apex(term, dopr_arg, step, term);
+            } else {
+                term = dopr_arg;
+            }
+
+            dopr_k[0] = dopr_k[6];
+            time += step;
+
+            while (term[2] < -M_PI) {
+                term[2] += 2 * M_PI;
+            }
+
+            while (term[2] > M_PI) {
+                term[2] -= 2 * M_PI;
+            }
+        }
+
+        fact = (err > 0) ? 0.9 * std::pow(err, -0.2) : 5;
+        step = std::max(step * std::min(std::max(fact, 0.2), 5.0), this->mpc_step);
+    }
+}
+
+void instance::comp_apex (const std::array<double, 6> & prev, const std::array<double, 6> & next, double step, std::array<double, 6> & apex) {
+    double coef_a, coef_b, coef_c, frac_min = 0, frac_max = 1, frac, altd;
 
-    this->comp_stat(estm, stat);
-    this->comp_pred(ctrl, stat, pred);
+    coef_a = 6 * prev[0] + 3 * step * prev[3] - 6 * next[0] + 3 * step * next[3];
+    coef_b = -6 * prev[0] - 4 * step * prev[3] + 6 * next[0] - 2 * step * next[3];
+    coef_c = step * prev[3];
+
+    for (int j = 0; j < 40; j++) {
+        frac = 0.5 * (frac_min + frac_max);
+        if ((coef_a * frac + coef_b) * frac + coef_c > 0) {
+            frac_min = frac;
+        } else {
+            frac_max = frac;
+        }
+    }
+
+    frac = 0.5 * (frac_min + frac_max);
+
+    altd = (2 * frac * frac * frac - 3 * frac * frac + 1) * prev[0]
+         + (frac * frac * frac - 2 * frac * frac + frac) * step * prev[3]
+         + (-2 * frac * frac * frac + 3 * frac * frac) * next[0]
+         + (frac * frac * frac - frac * frac) * step * next[3];
+
+    for (int i = 0; i < 6; i++) {
+        apex[i] = (1 - frac) * prev[i] + frac * next[i];
+    }
+
+    apex[0] = altd;
+    apex[3] = 0;
+}
+
+void instance::comp_apog (wrkr & wrkr, double ctrl, const std::array<double, 6> & pred, double & apog) {
+    std::array<double, 6> term;
+
+    if (pred[3] <= 0) {
+        apog = pred[0];
+        return;
+    }
+
+    if (this->srf_used) {
+        if (this->srf_find(pred, ctrl, apog)) {
+            return;
+        }
+        if (!this->srf_fall) {
+            throw except_comp_apog::fail;
+        }
+    }
+
+    this->comp_term(wrkr, ctrl, pred, term);
+
+    apog = term[0];
+}
+
+void instance::comp_categ (wrkr & wrkr, double ctrl, const linalg::fvector & estm, int & categ) {
+    std::array<double, 6> stat, pred;
+    double apog;
+
+    this->comp_stat(estm, 0, stat);
+    this->comp_pred(wrkr, ctrl, stat, pred);
 
     try {
-        this->comp_term(0, pred, term);
+        this->comp_apog(wrkr, 0, pred, apog);
+    } catch (except_comp_dead) {
+        throw;
     } catch (...) {
         throw except_comp_categ::fail;
     }
 
-    if (term[0] < this->mpc_apog) {
+    if (apog < this->mpc_apog) {
         categ = -1;
         return;
     }
 
     try {
-        this->comp_term(1, pred, term);
+        this->comp_apog(wrkr, 1, pred, apog);
+    } catch (except_comp_dead) {
+        throw;
     } catch (...) {
         throw except_comp_categ::fail;
     }
 
-    if (term[0] > this->mpc_apog) {
+    if (apog > this->mpc_apog) {
         categ = 1;
         return;
     }
@@ -802,4 +969,405 @@ void instance::comp_categ (double ctrl, const linalg::fvector & estm, int & cate
     categ = 0;
 }
 
+void instance::btch_derv (wrkr & wrkr, int size, const double * ctrl, const btch & stat, btch & derv) {
+    double pos_ver[btch::size], pos_ang[btch::size], vel_ver[btch::size], vel_hor[btch::size], vel_ang[btch::size];
+    double attk[btch::size], mach[btch::size], lift[btch::size], drag[btch::size], cprs[btch::size];
+    double pres[btch::size], temp[btch::size], dens[btch::size];
+    double vel_par[btch::size], vel_per[btch::size], vel_tot[btch::size], vel_snd[btch::size];
+    double forc_lift[btch::size], forc_drag[btch::size], forc_ver[btch::size], forc_hor[btch::size], torq[btch::size];
+    double cos_pos_ang[btch::size], sin_pos_ang[btch::size];
+    double forc_wght;
+
+    for (int n = 0; n < size; n++) {
+        pos_ver[n] = stat.val[0][n];
+        pos_ang[n] = stat.val[2][n];
+        vel_ver[n] = stat.val[3][n];
+        vel_hor[n] = stat.val[4][n];
+        vel_ang[n] = stat.val[5][n];
+    }
+
+    for (int n = 0; n < size; n++) {
+        this->atm_find(wrkr, pos_ver[n], pres[n], temp[n], dens[n]);
+    }
+
+    for (int n = 0; n < size; n++) {
+        cos_pos_ang[n] = std::cos(pos_ang[n]);
+        sin_pos_ang[n] = std::sin(pos_ang[n]);
+    }
+
+    for (int n = 0; n < size; n++) {
+        vel_par[n] = vel_ver[n] * cos_pos_ang[n] + vel_hor[n] * sin_pos_ang[n];
+        vel_per[n] = vel_hor[n] * cos_pos_ang[n] - vel_ver[n] * sin_pos_ang[n];
+        vel_tot[n] = std::sqrt(vel_ver[n] * vel_ver[n] + vel_hor[n] * vel_hor[n]);
+        vel_snd[n] = std::sqrt(this->env_gamma * this->env_gcnst * temp[n] / this->env_molar);
+        mach[n] = vel_tot[n] / vel_snd[n];
+    }
+
+    for (int n = 0; n < size; n++) {
+        attk[n] = std::atan2(vel_per[n], vel_par[n]);
+    }
+
+    for (int n = 0; n < size; n++) {
+        this->aer_tab.find(attk[n], mach[n], ctrl[n], lift[n], drag[n], cprs[n], wrkr.aer_hint);
+    }
+
+    forc_wght = this->vhc_mass * this->env_grvty;
+
+    for (int n = 0; n < size; n++) {
+        forc_lift[n] = 0.5 * dens[n] * vel_tot[n] * vel_tot[n] * this->vhc_area * lift[n] * attk[n];
+        forc_drag[n] = 0.5 * dens[n] * vel_tot[n] * vel_tot[n] * this->vhc_area * drag[n];
+        forc_ver[n] = forc_lift[n] * sin_pos_ang[n] - forc_drag[n] * cos_pos_ang[n] - forc_wght;
+        forc_hor[n] = -(forc_lift[n] * cos_pos_ang[n] + forc_drag[n] * sin_pos_ang[n]);
+        torq[n] = forc_lift[n] * (cprs[n] - this->vhc_cmas);
+    }
+
+    for (int n = 0; n < size; n++) {
+        if (!(vel_ver[n] > 0)) {
+            forc_ver[n] = -this->vhc_mass * this->env_grvty;
+            forc_hor[n] = 0;
+            torq[n] = 0;
+        }
+    }
+
+    for (int n = 0; n < size; n++) {
+        derv.val[0][n] = vel_ver[n];
+        derv.val[1][n] = vel_hor[n];
+        derv.val[2][n] = vel_ang[n];
+        derv.val[3][n] = forc_ver[n] / this->vhc_mass;
+        derv.val[4][n] = forc_hor[n] / this->vhc_mass;
+        derv.val[5][n] = torq[n] / this->vhc_iner;
+    }
+}
+
+void instance::btch_step (wrkr & wrkr, int size, const double * ctrl, const bool * live, btch & stat) {
+    btch runge_kutta_k1, runge_kutta_k2, runge_kutta_k3, runge_kutta_k4, runge_kutta_arg = {};
+    std::array<double, 6> prev, next;
+
+    this->comp_dead();
+
+    this->btch_derv(wrkr, size, ctrl, stat, runge_kutta_k1);
+
+    for (int i = 0; i < 6; i++) {
+        for (int n = 0; n < size; n++) {
+            runge_kutta_arg.val[i][n] = stat.val[i][n] + runge_kutta_k1.val[i][n] * this->mpc_step / 2;
+        }
+    }
+    this->btch_derv(wrkr, size, ctrl, runge_kutta_arg, runge_kutta_k2);
+
+    for (int i = 0; i < 6; i++) {
+        for (int n = 0; n < size; n++) {
+            runge_kutta_arg.val[i][n] = stat.val[i][n] + runge_kutta_k2.val[i][n] * this->mpc_step / 2;
+        }
+    }
+    this->btch_derv(wrkr, size, ctrl, runge_kutta_arg, runge_kutta_k3);
+
+    for (int i = 0; i < 6; i++) {
+        for (int n = 0; n < size; n++) {
+            runge_kutta_arg.val[i][n] = stat.val[i][n] + runge_kutta_k3.val[i][n] * this->mpc_step;
+        }
+    }
+    this->btch_derv(wrkr, size, ctrl, runge_kutta_arg, runge_kutta_k4);
+
+    for (int i = 0; i < 6; i++) {
+        for (int n = 0; n < size; n++) {
+            runge_kutta_arg.val[i][n] = stat.val[i][n] + (runge_kutta_k1.val[i][n] + 2 * runge_kutta_k2.val[i][n] + 2 * runge_kutta_k3.val[i][n] + runge_kutta_k4.val[i][n]) * this->mpc_step / 6;
+        }
+    }
+
+    for (int n = 0; n < size; n++) {
+        if (!live[n]) {
+            continue;
+        }
+
+        for (int i = 0; i < 6; i++) {
+            prev[i] = stat.val[i][n];
+            next[i] = runge_kutta_arg.val[i][n];
+        }
+
+        if (next[3] <= 0) {
+            this->comp_apex(prev, next, this->mpc_step, next);
+        }
+
+        while (next[2] < -M_PI) {
+            next[2] += 2 * M_PI;
+        }
+
+        while (next[2] > M_PI) {
+            next[2] -= 2 * M_PI;
+        }
+
+        for (int i = 0; i < 6; i++) {
+            stat.val[i][n] = next[i];
+        }
+    }
+}
+
+void instance::btch_pred (wrkr & wrkr, int size, const double * ctrl, btch & pred) {
+    bool live[btch::size], busy = true;
+    int count = 0;
+
+    while (this->mpc_phrz > count * this->mpc_step && busy) {
+        busy = false;
+        for (int n = 0; n < size; n++) {
+            live[n] = pred.val[3][n] > 0;
+            busy = busy || live[n];
+        }
+
+        if (!busy) {
+            break;
+        }
+
+        this->btch_step(wrkr, size, ctrl, live, pred);
+
+        count++;
+    }
+}
+
+void instance::btch_term (wrkr & wrkr, int size, const double * ctrl, btch & term) {
+    bool live[btch::size], busy = true;
+    int count = 0;
+
+    while (busy) {
+        busy = false;
+        for (int n = 0; n < size; n++) {
+            live[n] = term.val[3][n] > 0;
+            busy = busy || live[n];
+        }
+
+        if (!busy) {
+            break;
+        }
+
+        this->btch_step(wrkr, size, ctrl, live, term);
+
+        count++;
+
+        if (this->mpc_thrz <= count * this->mpc_step) {
+            throw except_btch_term::fail;
+        }
+    }
+}
+
+void instance::btch_categ (wrkr & wrkr, int size, struct cand * cand, const linalg::fvector & estm) {
+    std::array<double, 6> stat, pred, term;
+    btch pred_btch, term_btch;
+    double pred_ctrl[btch::size], term_ctrl[btch::size], apog[btch::size];
+    int term_lane[btch::size], term_size = 0;
+
+    this->comp_stat(estm, 0, stat);
+
+    for (int n = 0; n < size; n++) {
+        pred_ctrl[n] = cand[n].ctrl;
+        for (int i = 0; i < 6; i++) {
+            pred_btch.val[i][n] = stat[i];
+        }
+    }
+
+    this->btch_pred(wrkr, size, pred_ctrl, pred_btch);
+
+    for (int m = 0; m < 2 * size; m++) {
+        for (int i = 0; i < 6; i++) {
+            pred[i] = pred_btch.val[i][m % size];
+        }
+
+        if (pred[3] <= 0) {
+            apog[m] = pred[0];
+            continue;
+        }
+
+        if (this->srf_used) {
+            if (this->srf_find(pred, m / size, apog[m])) {
+                continue;
+            }
+            if (!this->srf_fall) {
+                throw except_btch_categ::fail;
+            }
+        }
+
+        if (this->mpc_adap) {
+            try {
+                this->comp_term(wrkr, m / size, pred, term);
+            } catch (except_comp_dead) {
+                throw;
+            } catch (...) {
+                throw except_btch_categ::fail;
+            }
+            apog[m] = term[0];
+            continue;
+        }
+
+        term_ctrl[term_size] = m / size;
+        term_lane[term_size] = m;
+        for (int i = 0; i < 6; i++) {
+            term_btch.val[i][term_size] = pred[i];
+        }
+        term_size++;
+    }
+
+    if (term_size > 0) {
+        try {
+            this->btch_term(wrkr, term_size, term_ctrl, term_btch);
+        } catch (except_comp_dead) {
+            throw;
+        } catch (...) {
+            throw except_btch_categ::fail;
+        }
+    }
+
+    for (int n = 0; n < term_size; n++) {
+        apog[term_lane[n]] = term_btch.val[0][n];
+    }
+
+    for (int n = 0; n < size; n++) {
+        if (apog[n] < this->mpc_apog) {
+            cand[n].categ = -1;
+        } else if (apog[size + n] > this->mpc_apog) {
+            cand[n].categ = 1;
+        } else {
+            cand[n].categ = 0;
+        }
+    }
+}
+
+void instance::wrkr_start (void) {
+    this->logging.inf("Starting worker threads");
+
+    this->wrkr_dat = std::vector<wrkr>(this->mpc_wrkr);
+    this->cand_dat = std::vector<cand>(std::max(this->mpc_wrkr * this->mpc_btch, 2));
+
+    try {
+        for (int i = 1; i < this->mpc_wrkr; i++) {
+            this->wrkr_thrd.emplace_back(&instance::wrkr_loop, this, i);
+        }
+    } catch (...) {
+        this->logging.err("Failed to start worker threads");
+        this->wrkr_halt();
+        throw except_wrkr_start::fail;
+    }
+}
+
+void instance::wrkr_halt (void) {
+    this->logging.inf("Stopping worker threads");
+
+    {
+        std::lock_guard<std::mutex> lock(this->wrkr_mutx);
+        this->wrkr_stop = true;
+    }
+
+    this->wrkr_cond_strt.notify_all();
+
+    for (auto & elem : this->wrkr_thrd) {
+        elem.join();
+    }
+
+    this->wrkr_thrd.clear();
+}
+
+void instance::wrkr_loop (int idx) {
+    std::unique_lock<std::mutex> lock(this->wrkr_mutx);
+    int round = 0;
+
+    while (true) {
+        this->wrkr_cond_strt.wait(lock, [&] { return this->wrkr_stop || this->wrkr_round != round; });
+
+        if (this->wrkr_stop) {
+            return;
+        }
+
+        round = this->wrkr_round;
+
+        lock.unlock();
+        this->wrkr_work(idx);
+        lock.lock();
+
+        this->wrkr_pend--;
+        if (this->wrkr_pend == 0) {
+            this->wrkr_cond_done.notify_one();
+        }
+    }
+}
+
+void instance::wrkr_work (int idx) {
+    int size;
+
+    if (this->mpc_btch == 1) {
+        for (int i = idx; i < this->wrkr_size; i += this->mpc_wrkr) {
+            try {
+                this->comp_categ(this->wrkr_dat[idx], this->cand_dat[i].ctrl, *this->wrkr_estm, this->cand_dat[i].categ);
+                this->cand_dat[i].fail = false;
+                this->cand_dat[i].late = false;
+            } catch (except_comp_dead) {
+                this->cand_dat[i].fail = true;
+                this->cand_dat[i].late = true;
+            } catch (...) {
+                this->cand_dat[i].fail = true;
+                this->cand_dat[i].late = false;
+            }
+        }
+        return;
+    }
+
+    for (int i = idx * this->mpc_btch; i < this->wrkr_size; i += this->mpc_wrkr * this->mpc_btch) {
+        size = std::min(this->mpc_btch, this->wrkr_size - i);
+        try {
+            this->btch_categ(this->wrkr_dat[idx], size, &this->cand_dat[i], *this->wrkr_estm);
+            for (int n = 0; n < size; n++) {
+                this->cand_dat[i + n].fail = false;
+                this->cand_dat[i + n].late = false;
+            }
+        } catch (except_comp_dead) {
+            for (int n = 0; n < size; n++) {
+                this->cand_dat[i + n].fail = true;
+                this->cand_dat[i + n].late = true;
+            }
+        } catch (...) {
+            for (int n = 0; n < size; n++) {
+                this->cand_dat[i + n].fail = true;
+                this->cand_dat[i + n].late = false;
+            }
+        }
+    }
+}
+
+bool instance::wrkr_eval (const linalg::fvector & estm, int size) {
+    bool late = false;
+
+    if (size <= 1) {
+        this->wrkr_estm = &estm;
+        this->wrkr_size = size;
+
+        this->eval_count += size;
+
+        this->wrkr_work(0);
+    } else {
+        {
+            std::lock_guard<std::mutex> lock(this->wrkr_mutx);
+            this->wrkr_estm = &estm;
+            this->wrkr_size = size;
+            this->wrkr_pend = this->mpc_wrkr - 1;
+            this->wrkr_round++;
+        }
+
+        this->wrkr_cond_strt.notify_all();
+
+        this->eval_count += size;
+
+        this->wrkr_work(0);
+
+        {
+            std::unique_lock<std::mutex> lock(this->wrkr_mutx);
+            this->wrkr_cond_done.wait(lock, [&] { return this->wrkr_pend == 0; });
+        }
+    }
+
+    for (int i = 0; i < size; i++) {
+        if (this->cand_dat[i].fail && !this->cand_dat[i].late) {
+            throw except_wrkr_eval::fail;
+        }
+        late = late || this->cand_dat[i].late;
+    }
+
+    return !late;
+}
+
 }
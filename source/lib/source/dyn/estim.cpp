@@ -6,6 +6,7 @@
 #include <vector>
 
 #include <math/linalg.hpp>
+#include <math/lookup.hpp>
 #include <sys/logging.hpp>
 #include <dat/csvread.hpp>
 #include <dyn/estim.hpp>
@@ -217,6 +218,9 @@ void instance::atm_load (void) {
             throw except_atm_load::fail;
         }
     }
+
+    this->atm_step = lookup::step(this->atm_pres);
+    this->atm_hint = 0;
 }
 
 void instance::atm_find (double pres, double & altd) {
@@ -224,13 +228,7 @@ void instance::atm_find (double pres, double & altd) {
     double pres_mean, pres_diff;
     double altd_mean, altd_grad_pres;
 
-    if (pres < this->atm_pres.front()) {
-        pres_idx1 = 0;
-    } else if (pres >= this->atm_pres.back()) {
-        pres_idx1 = this->atm_pres.size() - 2;
-    } else {
-        pres_idx1 = std::distance(this->atm_pres.begin(), std::upper_bound(this->atm_pres.begin(), this->atm_pres.end(), pres)) - 1;
-    }
+    pres_idx1 = lookup::find(this->atm_pres, this->atm_step, pres, this->atm_hint);
     pres_idx2 = pres_idx1 + 1;
 
     pres_mean = 0.5 * (this->atm_pres[pres_idx1] + this->atm_pres[pres_idx2]);
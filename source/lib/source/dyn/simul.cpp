@@ -6,9 +6,11 @@
 #include <vector>
 
 #include <math/linalg.hpp>
+#include <math/lookup.hpp>
 #include <math/randnum.hpp>
 #include <sys/logging.hpp>
 #include <dat/csvread.hpp>
+#include <dyn/aertab.hpp>
 #include <dyn/simul.hpp>
 
 namespace simul {
@@ -34,7 +36,7 @@ instance::instance (
     double act_turn
 ) try
   : logging("simul"), init(false),
-    aer_dat(aer_path), atm_dat(atm_path),
+    aer_tab(aer_path), aer_hint{0, 0, 0}, atm_dat(atm_path),
     env_grvty(env_grvty), env_gcnst(env_gcnst), env_molar(env_molar), env_gamma(env_gamma),
     vhc_mass(vhc_mass), vhc_iner(vhc_iner), vhc_cmas(vhc_cmas), vhc_area(vhc_area),
     imu_rot_var(imu_rot_var), imu_qua_var(imu_qua_var), imu_lia_var(imu_lia_var),
@@ -157,7 +159,6 @@ instance::instance (
     }
 
     try {
-        this->aer_load();
         this->atm_load();
     } catch (...) {
         this->logging.err("Failed to initialize instance");
@@ -165,6 +166,8 @@ instance::instance (
     }
 
     this->init = true;
+} catch (aertab::instance::except_ctor) {
+    throw except_ctor::fail;
 } catch (csvread::instance::except_ctor) {
     throw except_ctor::fail;
 }
@@ -349,319 +352,6 @@ void instance::update (void) {
     this->sens_valid = true;
 }
 
-void instance::aer_load (void) {
-    std::vector<std::string> head;
-    std::vector<double> body;
-    std::vector<std::vector<double>> data;
-    std::vector<std::vector<std::vector<bool>>> covered;
-    double attk, mach, brak, lift, drag, cprs;
-    int attk_col, mach_col, brak_col, lift_col, drag_col, cprs_col;
-    int attk_idx, mach_idx, brak_idx;
-
-    this->logging.inf("Creating aerodynamic lookup table");
-
-    try {
-        head = this->aer_dat.get_head();
-    } catch (...) {
-        this->logging.err("Failed to create aerodynamic lookup table");
-        throw except_aer_load::fail;
-    }
-
-    attk_col = std::distance(head.begin(), std::find(head.begin(), head.end(), "Angle of attack (rad)"));
-    mach_col = std::distance(head.begin(), std::find(head.begin(), head.end(), "Mach number"));
-    brak_col = std::distance(head.begin(), std::find(head.begin(), head.end(), "Brake deployment"));
-    lift_col = std::distance(head.begin(), std::find(head.begin(), head.end(), "Lift coefficient"));
-    drag_col = std::distance(head.begin(), std::find(head.begin(), head.end(), "Drag coefficient"));
-    cprs_col = std::distance(head.begin(), std::find(head.begin(), head.end(), "Center of pressure (m)"));
-
-    if (
-           attk_col == int(head.size()) || mach_col == int(head.size()) || brak_col == int(head.size())
-        || lift_col == int(head.size()) || drag_col == int(head.size()) || cprs_col == int(head.size())
-    ) {
-        this->logging.err("Failed to create aerodynamic lookup table (Missing column)");
-        throw except_aer_load::fail;
-    }
-
-    try {
-        while (true) {
-            body = this->aer_dat.get_body();
-
-            attk = body[attk_col];
-            mach = body[mach_col];
-            brak = body[brak_col];
-            lift = body[lift_col];
-            drag = body[drag_col];
-            cprs = body[cprs_col];
-
-            data.push_back({attk, mach, brak, lift, drag, cprs});
-        }
-    } catch (csvread::instance::except_get_body except) {
-        switch (except) {
-            case csvread::instance::except_get_body::fail:
-                this->logging.err("Failed to create aerodynamic lookup table");
-                throw except_aer_load::fail;
-            case csvread::instance::except_get_body::eof:
-                break;
-        }
-    }
-
-    for (auto itr = data.begin(); itr < data.end(); itr++) {
-        if (!std::binary_search(this->aer_attk.begin(), this->aer_attk.end(), (*itr)[0])) {
-            this->aer_attk.insert(std::lower_bound(this->aer_attk.begin(), this->aer_attk.end(), (*itr)[0]), (*itr)[0]);
-        }
-        if (!std::binary_search(this->aer_mach.begin(), this->aer_mach.end(), (*itr)[1])) {
-            this->aer_mach.insert(std::lower_bound(this->aer_mach.begin(), this->aer_mach.end(), (*itr)[1]), (*itr)[1]);
-        }
-        if (!std::binary_search(this->aer_brak.begin(), this->aer_brak.end(), (*itr)[2])) {
-            this->aer_brak.insert(std::lower_bound(this->aer_brak.begin(), this->aer_brak.end(), (*itr)[2]), (*itr)[2]);
-        }
-    }
-
-    if (this->aer_attk.size() < 2 || this->aer_mach.size() < 2 || this->aer_brak.size() < 2) {
-        this->logging.err("Failed to create aerodynamic lookup table (Insufficient data)");
-        throw except_aer_load::fail;
-    }
-
-    this->aer_lift = std::vector<std::vector<std::vector<double>>>(
-        this->aer_attk.size(), std::vector<std::vector<double>>(
-            this->aer_mach.size(), std::vector<double>(
-                this->aer_brak.size()
-            )
-        )
-    );
-
-    this->aer_drag = std::vector<std::vector<std::vector<double>>>(
-        this->aer_attk.size(), std::vector<std::vector<double>>(
-            this->aer_mach.size(), std::vector<double>(
-                this->aer_brak.size()
-            )
-        )
-    );
-
-    this->aer_cprs = std::vector<std::vector<std::vector<double>>>(
-        this->aer_attk.size(), std::vector<std::vector<double>>(
-            this->aer_mach.size(), std::vector<double>(
-                this->aer_brak.size()
-            )
-        )
-    );
-
-    covered = std::vector<std::vector<std::vector<bool>>>(
-        this->aer_attk.size(), std::vector<std::vector<bool>>(
-            this->aer_mach.size(), std::vector<bool>(
-                this->aer_brak.size(), false
-            )
-        )
-    );
-
-    for (auto itr = data.begin(); itr < data.end(); itr++) {
-        attk_idx = std::distance(this->aer_attk.begin(), std::find(this->aer_attk.begin(), this->aer_attk.end(), (*itr)[0]));
-        mach_idx = std::distance(this->aer_mach.begin(), std::find(this->aer_mach.begin(), this->aer_mach.end(), (*itr)[1]));
-        brak_idx = std::distance(this->aer_brak.begin(), std::find(this->aer_brak.begin(), this->aer_brak.end(), (*itr)[2]));
-
-        if (covered[attk_idx][mach_idx][brak_idx]) {
-            this->logging.err("Failed to create aerodynamic lookup table (Repeated data point)");
-            throw except_aer_load::fail;
-        }
-
-        this->aer_lift[attk_idx][mach_idx][brak_idx] = (*itr)[3];
-        this->aer_drag[attk_idx][mach_idx][brak_idx] = (*itr)[4];
-        this->aer_cprs[attk_idx][mach_idx][brak_idx] = (*itr)[5];
-
-        covered[attk_idx][mach_idx][brak_idx] = true;
-    }
-
-    for (auto elem1 : covered) {
-        for (auto elem2 : elem1) {
-            for (auto elem3 : elem2) {
-                if (!elem3) {
-                    this->logging.err("Failed to create aerodynamic lookup table (Missing data point)");
-                    throw except_aer_load::fail;
-                }
-            }
-        }
-    }
-}
-
-void instance::aer_find (double attk, double mach, double brak, double & lift, double & drag, double & cprs) {
-    int attk_idx1, attk_idx2, mach_idx1, mach_idx2, brak_idx1, brak_idx2;
-    double attk_mean, mach_mean, brak_mean, attk_diff, mach_diff, brak_diff;
-    double lift_mean, lift_grad_attk, lift_grad_mach, lift_grad_brak;
-    double drag_mean, drag_grad_attk, drag_grad_mach, drag_grad_brak;
-    double cprs_mean, cprs_grad_attk, cprs_grad_mach, cprs_grad_brak;
-
-    if (attk < this->aer_attk.front()) {
-        attk_idx1 = 0;
-    } else if (attk >= this->aer_attk.back()) {
-        attk_idx1 = this->aer_attk.size() - 2;
-    } else {
-        attk_idx1 = std::distance(this->aer_attk.begin(), std::upper_bound(this->aer_attk.begin(), this->aer_attk.end(), attk)) - 1;
-    }
-    attk_idx2 = attk_idx1 + 1;
-
-    if (mach < this->aer_mach.front()) {
-        mach_idx1 = 0;
-    } else if (mach >= this->aer_mach.back()) {
-        mach_idx1 = this->aer_mach.size() - 2;
-    } else {
-        mach_idx1 = std::distance(this->aer_mach.begin(), std::upper_bound(this->aer_mach.begin(), this->aer_mach.end(), mach)) - 1;
-    }
-    mach_idx2 = mach_idx1 + 1;
-
-    if (brak < this->aer_brak.front()) {
-        brak_idx1 = 0;
-    } else if (brak >= this->aer_brak.back()) {
-        brak_idx1 = this->aer_brak.size() - 2;
-    } else {
-        brak_idx1 = std::distance(this->aer_brak.begin(), std::upper_bound(this->aer_brak.begin(), this->aer_brak.end(), brak)) - 1;
-    }
-    brak_idx2 = brak_idx1 + 1;
-
-    attk_mean = 0.5 * (this->aer_attk[attk_idx1] + this->aer_attk[attk_idx2]);
-    mach_mean = 0.5 * (this->aer_mach[mach_idx1] + this->aer_mach[mach_idx2]);
-    brak_mean = 0.5 * (this->aer_brak[brak_idx1] + this->aer_brak[brak_idx2]);
-
-    attk_diff = attk - attk_mean;
-    mach_diff = mach - mach_mean;
-    brak_diff = brak - brak_mean;
-
-    lift_mean = 0.125 * (
-        + this->aer_lift[attk_idx1][mach_idx1][brak_idx1]
-        + this->aer_lift[attk_idx1][mach_idx1][brak_idx2]
-        + this->aer_lift[attk_idx1][mach_idx2][brak_idx1]
-        + this->aer_lift[attk_idx1][mach_idx2][brak_idx2]
-        + this->aer_lift[attk_idx2][mach_idx1][brak_idx1]
-        + this->aer_lift[attk_idx2][mach_idx1][brak_idx2]
-        + this->aer_lift[attk_idx2][mach_idx2][brak_idx1]
-        + this->aer_lift[attk_idx2][mach_idx2][brak_idx2]
-    );
-
-    lift_grad_attk = 0.25 * (
-        - this->aer_lift[attk_idx1][mach_idx1][brak_idx1]
-        - this->aer_lift[attk_idx1][mach_idx1][brak_idx2]
-        - this->aer_lift[attk_idx1][mach_idx2][brak_idx1]
-        - this->aer_lift[attk_idx1][mach_idx2][brak_idx2]
-        + this->aer_lift[attk_idx2][mach_idx1][brak_idx1]
-        + this->aer_lift[attk_idx2][mach_idx1][brak_idx2]
-        + this->aer_lift[attk_idx2][mach_idx2][brak_idx1]
-        + this->aer_lift[attk_idx2][mach_idx2][brak_idx2]
-    ) / (this->aer_attk[attk_idx2] - this->aer_attk[attk_idx1]);
-
-    lift_grad_mach = 0.25 * (
-        - this->aer_lift[attk_idx1][mach_idx1][brak_idx1]
-        - this->aer_lift[attk_idx1][mach_idx1][brak_idx2]
-        + this->aer_lift[attk_idx1][mach_idx2][brak_idx1]
-        + this->aer_lift[attk_idx1][mach_idx2][brak_idx2]
-        - this->aer_lift[attk_idx2][mach_idx1][brak_idx1]
-        - this->aer_lift[attk_idx2][mach_idx1][brak_idx2]
-        + this->aer_lift[attk_idx2][mach_idx2][brak_idx1]
-        + this->aer_lift[attk_idx2][mach_idx2][brak_idx2]
-    ) / (this->aer_mach[mach_idx2] - this->aer_mach[mach_idx1]);
-
-    lift_grad_brak = 0.25 * (
-        - this->aer_lift[attk_idx1][mach_idx1][brak_idx1]
-        + this->aer_lift[attk_idx1][mach_idx1][brak_idx2]
-        - this->aer_lift[attk_idx1][mach_idx2][brak_idx1]
-        + this->aer_lift[attk_idx1][mach_idx2][brak_idx2]
-        - this->aer_lift[attk_idx2][mach_idx1][brak_idx1]
-        + this->aer_lift[attk_idx2][mach_idx1][brak_idx2]
-        - this->aer_lift[attk_idx2][mach_idx2][brak_idx1]
-        + this->aer_lift[attk_idx2][mach_idx2][brak_idx2]
-    ) / (this->aer_brak[brak_idx2] - this->aer_brak[brak_idx1]);
-
-    drag_mean = 0.125 * (
-        + this->aer_drag[attk_idx1][mach_idx1][brak_idx1]
-        + this->aer_drag[attk_idx1][mach_idx1][brak_idx2]
-        + this->aer_drag[attk_idx1][mach_idx2][brak_idx1]
-        + this->aer_drag[attk_idx1][mach_idx2][brak_idx2]
-        + this->aer_drag[attk_idx2][mach_idx1][brak_idx1]
-        + this->aer_drag[attk_idx2][mach_idx1][brak_idx2]
-        + this->aer_drag[attk_idx2][mach_idx2][brak_idx1]
-        + this->aer_drag[attk_idx2][mach_idx2][brak_idx2]
-    );
-
-    drag_grad_attk = 0.25 * (
-        - this->aer_drag[attk_idx1][mach_idx1][brak_idx1]
-        - this->aer_drag[attk_idx1][mach_idx1][brak_idx2]
-        - this->aer_drag[attk_idx1][mach_idx2][brak_idx1]
-        - this->aer_drag[attk_idx1][mach_idx2][brak_idx2]
-        + this->aer_drag[attk_idx2][mach_idx1][brak_idx1]
-        + this->aer_drag[attk_idx2][mach_idx1][brak_idx2]
-        + this->aer_drag[attk_idx2][mach_idx2][brak_idx1]
-        + this->aer_drag[attk_idx2][mach_idx2][brak_idx2]
-    ) / (this->aer_attk[attk_idx2] - this->aer_attk[attk_idx1]);
-
-    drag_grad_mach = 0.25 * (
-        - this->aer_drag[attk_idx1][mach_idx1][brak_idx1]
-        - this->aer_drag[attk_idx1][mach_idx1][brak_idx2]
-        + this->aer_drag[attk_idx1][mach_idx2][brak_idx1]
-        + this->aer_drag[attk_idx1][mach_idx2][brak_idx2]
-        - this->aer_drag[attk_idx2][mach_idx1][brak_idx1]
-        - this->aer_drag[attk_idx2][mach_idx1][brak_idx2]
-        + this->aer_drag[attk_idx2][mach_idx2][brak_idx1]
-        + this->aer_drag[attk_idx2][mach_idx2][brak_idx2]
-    ) / (this->aer_mach[mach_idx2] - this->aer_mach[mach_idx1]);
-
-    drag_grad_brak = 0.25 * (
-        - this->aer_drag[attk_idx1][mach_idx1][brak_idx1]
-        + this->aer_drag[attk_idx1][mach_idx1][brak_idx2]
-        - this->aer_drag[attk_idx1][mach_idx2][brak_idx1]
-        + this->aer_drag[attk_idx1][mach_idx2][brak_idx2]
-        - this->aer_drag[attk_idx2][mach_idx1][brak_idx1]
-        + this->aer_drag[attk_idx2][mach_idx1][brak_idx2]
-        - this->aer_drag[attk_idx2][mach_idx2][brak_idx1]
-        + this->aer_drag[attk_idx2][mach_idx2][brak_idx2]
-    ) / (this->aer_brak[brak_idx2] - this->aer_brak[brak_idx1]);
-
-    cprs_mean = 0.125 * (
-        + this->aer_cprs[attk_idx1][mach_idx1][brak_idx1]
-        + this->aer_cprs[attk_idx1][mach_idx1][brak_idx2]
-        + this->aer_cprs[attk_idx1][mach_idx2][brak_idx1]
-        + this->aer_cprs[attk_idx1][mach_idx2][brak_idx2]
-        + this->aer_cprs[attk_idx2][mach_idx1][brak_idx1]
-        + this->aer_cprs[attk_idx2][mach_idx1][brak_idx2]
-        + this->aer_cprs[attk_idx2][mach_idx2][brak_idx1]
-        + this->aer_cprs[attk_idx2][mach_idx2][brak_idx2]
-    );
-
-    cprs_grad_attk = 0.25 * (
-        - this->aer_cprs[attk_idx1][mach_idx1][brak_idx1]
-        - this->aer_cprs[attk_idx1][mach_idx1][brak_idx2]
-        - this->aer_cprs[attk_idx1][mach_idx2][brak_idx1]
-        - this->aer_cprs[attk_idx1][mach_idx2][brak_idx2]
-        + this->aer_cprs[attk_idx2][mach_idx1][brak_idx1]
-        + this->aer_cprs[attk_idx2][mach_idx1][brak_idx2]
-        + this->aer_cprs[attk_idx2][mach_idx2][brak_idx1]
-        + this->aer_cprs[attk_idx2][mach_idx2][brak_idx2]
-    ) / (this->aer_attk[attk_idx2] - this->aer_attk[attk_idx1]);
-
-    cprs_grad_mach = 0.25 * (
-        - this->aer_cprs[attk_idx1][mach_idx1][brak_idx1]
-        - this->aer_cprs[attk_idx1][mach_idx1][brak_idx2]
-        + this->aer_cprs[attk_idx1][mach_idx2][brak_idx1]
-        + this->aer_cprs[attk_idx1][mach_idx2][brak_idx2]
-        - this->aer_cprs[attk_idx2][mach_idx1][brak_idx1]
-        - this->aer_cprs[attk_idx2][mach_idx1][brak_idx2]
-        + this->aer_cprs[attk_idx2][mach_idx2][brak_idx1]
-        + this->aer_cprs[attk_idx2][mach_idx2][brak_idx2]
-    ) / (this->aer_mach[mach_idx2] - this->aer_mach[mach_idx1]);
-
-    cprs_grad_brak = 0.25 * (
-        - this->aer_cprs[attk_idx1][mach_idx1][brak_idx1]
-        + this->aer_cprs[attk_idx1][mach_idx1][brak_idx2]
-        - this->aer_cprs[attk_idx1][mach_idx2][brak_idx1]
-        + this->aer_cprs[attk_idx1][mach_idx2][brak_idx2]
-        - this->aer_cprs[attk_idx2][mach_idx1][brak_idx1]
-        + this->aer_cprs[attk_idx2][mach_idx1][brak_idx2]
-        - this->aer_cprs[attk_idx2][mach_idx2][brak_idx1]
-        + this->aer_cprs[attk_idx2][mach_idx2][brak_idx2]
-    ) / (this->aer_brak[brak_idx2] - this->aer_brak[brak_idx1]);
-
-    lift = lift_mean + lift_grad_attk * attk_diff + lift_grad_mach * mach_diff + lift_grad_brak * brak_diff;
-    drag = drag_mean + drag_grad_attk * attk_diff + drag_grad_mach * mach_diff + drag_grad_brak * brak_diff;
-    cprs = cprs_mean + cprs_grad_attk * attk_diff + cprs_grad_mach * mach_diff + cprs_grad_brak * brak_diff;
-}
-
 void instance::atm_load (void) {
     std::vector<std::string> head;
     std::vector<double> body;
@@ -749,6 +439,9 @@ void instance::atm_load (void) {
             throw except_atm_load::fail;
         }
     }
+
+    this->atm_step = lookup::step(this->atm_altd);
+    this->atm_hint = 0;
 }
 
 void instance::atm_find (double altd, double & pres, double & temp, double & dens) {
@@ -758,13 +451,7 @@ void instance::atm_find (double altd, double & pres, double & temp, double & den
     double temp_mean, temp_grad_altd;
     double dens_mean, dens_grad_altd;
 
-    if (altd < this->atm_altd.front()) {
-        altd_idx1 = 0;
-    } else if (altd >= this->atm_altd.back()) {
-        altd_idx1 = this->atm_altd.size() - 2;
-    } else {
-        altd_idx1 = std::distance(this->atm_altd.begin(), std::upper_bound(this->atm_altd.begin(), this->atm_altd.end(), altd)) - 1;
-    }
+    altd_idx1 = lookup::find(this->atm_altd, this->atm_step, altd, this->atm_hint);
     altd_idx2 = altd_idx1 + 1;
 
     altd_mean = 0.5 * (this->atm_altd[altd_idx1] + this->atm_altd[altd_idx2]);
@@ -834,7 +521,7 @@ void instance::comp_derv (double ctrl, const linalg::fvector & stat, linalg::fve
 
         attk = std::atan2(vel_per, vel_par);
         mach = vel_tot / vel_snd;
-        this->aer_find(attk, mach, brak, lift, drag, cprs);
+        this->aer_tab.find(attk, mach, brak, lift, drag, cprs, this->aer_hint);
 
         forc_wght = this->vhc_mass * this->env_grvty;
         forc_lift = 0.5 * dens * vel_tot * vel_tot * this->vhc_area * lift * attk;
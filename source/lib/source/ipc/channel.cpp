@@ -1,9 +1,27 @@
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <ctime>
+
+#include <atomic>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+#include <signal.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
 
 #include <math/linalg.hpp>
 #include <sys/logging.hpp>
 #include <ipc/semaphore.hpp>
-#include <ipc/sharedmem.hpp>
+#include <ipc/seqlock.hpp>
 #include <ipc/channel.hpp>
 
 namespace channel {
@@ -19,82 +37,153 @@ bool tracker::instantiate (void) {
     }
 }
 
-instance::instance (mode mode) try
-  : logging("channel"), init(false), locked(false),
+instance::instance (mode mode) : instance("channel", "acces", mode) {}
+
+instance::instance (const std::string & name, const std::string & acces, mode mode) try
+  : logging("channel"), init(false), locked(false), writer(false), held(false), owned(false),
     acces(
-        "acces",
+        acces,
         (mode == mode::none) ? semaphore::mode::none :
         (mode == mode::create) ? semaphore::mode::create :
         (mode == mode::remove) ? semaphore::mode::remove : semaphore::mode::both
     ),
-    ctrl_drdy(
-        "ctrl-drdy",
-        (mode == mode::none) ? sharedmem::mode::none :
-        (mode == mode::create) ? sharedmem::mode::create :
-        (mode == mode::remove) ? sharedmem::mode::remove : sharedmem::mode::both
-    ),
-    stat_drdy(
-        "stat-drdy",
-        (mode == mode::none) ? sharedmem::mode::none :
-        (mode == mode::create) ? sharedmem::mode::create :
-        (mode == mode::remove) ? sharedmem::mode::remove : sharedmem::mode::both
-    ),
-    estm_drdy(
-        "estm-drdy",
-        (mode == mode::none) ? sharedmem::mode::none :
-        (mode == mode::create) ? sharedmem::mode::create :
-        (mode == mode::remove) ? sharedmem::mode::remove : sharedmem::mode::both
-    ),
-    sens_drdy(
-        "sens-drdy",
-        (mode == mode::none) ? sharedmem::mode::none :
-        (mode == mode::create) ? sharedmem::mode::create :
-        (mode == mode::remove) ? sharedmem::mode::remove : sharedmem::mode::both
-    ),
-    ctrl_data(
-        "ctrl-data",
-        (mode == mode::none) ? sharedmem::mode::none :
-        (mode == mode::create) ? sharedmem::mode::create :
-        (mode == mode::remove) ? sharedmem::mode::remove : sharedmem::mode::both
-    ),
-    stat_data(
-        "stat-data", 7,
-        (mode == mode::none) ? sharedmem::mode::none :
-        (mode == mode::create) ? sharedmem::mode::create :
-        (mode == mode::remove) ? sharedmem::mode::remove : sharedmem::mode::both
-    ),
-    estm_data(
-        "estm-data", 4,
-        (mode == mode::none) ? sharedmem::mode::none :
-        (mode == mode::create) ? sharedmem::mode::create :
-        (mode == mode::remove) ? sharedmem::mode::remove : sharedmem::mode::both
-    ),
-    sens_data(
-        "sens-data", 17,
-        (mode == mode::none) ? sharedmem::mode::none :
-        (mode == mode::create) ? sharedmem::mode::create :
-        (mode == mode::remove) ? sharedmem::mode::remove : sharedmem::mode::both
-    ) {
-    this->logging.inf("Initializing instance");
+    name(name), len(sizeof(segment)),
+    create(mode == mode::create || mode == mode::both), remove(mode == mode::remove || mode == mode::both) {
+
+    bool obj_open = false, obj_map = false;
+    int ret, desc;
+    void * addr;
+
+    this->logging.inf("Initializing instance: Name: ", this->name);
 
     if (!instance::instantiate()) {
         this->logging.err("Failed to initialize instance (Instance already exists)");
         throw except_ctor::fail;
     }
 
+    try {
+        this->logging.inf("Opening shared memory object");
+        if (this->create) {
+            desc = shm_open(this->name.c_str(), O_RDWR | O_CREAT, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH);
+        } else {
+            desc = shm_open(this->name.c_str(), O_RDWR, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH);
+        }
+        if (desc < 0) {
+            this->logging.err("Failed to open shared memory object (", std::strerror(errno), ")");
+            throw except_intern{};
+        }
+
+        obj_open = true;
+
+        this->logging.inf("Resizing shared memory object");
+        ret = ftruncate(desc, this->len);
+        if (ret < 0) {
+            this->logging.err("Failed to resize shared memory object (", std::strerror(errno), ")");
+            throw except_intern{};
+        }
+
+        this->logging.inf("Mapping shared memory region");
+        addr = mmap(NULL, this->len, PROT_READ | PROT_WRITE, MAP_SHARED, desc, 0);
+        if (addr == MAP_FAILED) {
+            this->logging.err("Failed to map shared memory region (", std::strerror(errno), ")");
+            throw except_intern{};
+        }
+
+        obj_map = true;
+
+        if (this->create) {
+            this->seg = new (addr) segment();
+            this->seg->vers = instance::seg_vers;
+        } else {
+            this->seg = static_cast<segment *>(addr);
+        }
+
+        obj_open = false;
+
+        this->logging.inf("Closing shared memory object");
+        ret = close(desc);
+        if (ret < 0) {
+            this->logging.err("Failed to close shared memory object (", std::strerror(errno), ")");
+            throw except_intern{};
+        }
+
+        if (this->seg->vers != instance::seg_vers) {
+            this->logging.err("Failed to map shared memory region (Incompatible layout version)");
+            throw except_intern{};
+        }
+
+        this->ctrl_last = this->seg->ctrl.seq.load(std::memory_order_acquire);
+        this->stat_last = this->seg->stat.seq.load(std::memory_order_acquire);
+        this->estm_last = this->seg->estm.seq.load(std::memory_order_acquire);
+        this->sens_last = this->seg->sens.seq.load(std::memory_order_acquire);
+
+        this->ctrl_curs = this->seg->ctrl.head.load(std::memory_order_acquire);
+        this->stat_curs = this->seg->stat.head.load(std::memory_order_acquire);
+        this->estm_curs = this->seg->estm.head.load(std::memory_order_acquire);
+        this->sens_curs = this->seg->sens.head.load(std::memory_order_acquire);
+    } catch (except_intern) {
+        if (obj_open) {
+            this->logging.wrn("Closing shared memory object");
+            ret = close(desc);
+            if (ret < 0) {
+                this->logging.err("Failed to close shared memory object (", std::strerror(errno), ")");
+            }
+        }
+
+        if (obj_map) {
+            this->logging.wrn("Unmapping shared memory region");
+            ret = munmap(addr, this->len);
+            if (ret < 0) {
+                this->logging.err("Failed to unmap shared memory region (", std::strerror(errno), ")");
+            }
+        }
+
+        this->logging.err("Failed to initialize instance");
+        throw except_ctor::fail;
+    }
+
     this->init = true;
 } catch (semaphore::instance::except_ctor) {
     throw except_ctor::fail;
-} catch (sharedmem::instance<bool>::except_ctor) {
-    throw except_ctor::fail;
-} catch (sharedmem::instance<double>::except_ctor) {
-    throw except_ctor::fail;
-} catch (sharedmem::instance<linalg::fvector>::except_ctor) {
-    throw except_ctor::fail;
+}
+
+instance::~instance (void) {
+    int ret;
+
+    if (this->init) {
+        if (this->owned) {
+            this->logging.inf("Unlocking access mutex");
+            ret = pthread_mutex_unlock(&this->seg->mutx);
+            if (ret != 0) {
+                this->logging.err("Failed to unlock access mutex (", std::strerror(ret), ")");
+            }
+        }
+
+        this->logging.inf("Unmapping shared memory region");
+        ret = munmap(this->seg, this->len);
+        if (ret < 0) {
+            this->logging.err("Failed to unmap shared memory region (", std::strerror(errno), ")");
+        }
+
+        if (this->remove) {
+            this->logging.inf("Unlinking shared memory object");
+            ret = shm_unlink(this->name.c_str());
+            if (ret < 0) {
+                this->logging.err("Failed to unlink shared memory object (", std::strerror(errno), ")");
+            }
+        }
+    }
 }
 
 void instance::put_ctrl (double ctrl) {
-    this->logging.inf("Writing control signal to channel: Ctrl: ", ctrl);
+    this->put_ctrl(ctrl, instance::time_now());
+}
+
+void instance::put_ctrl (double ctrl, double orig) {
+    double buf[1];
+    status ret;
+
+    this->logging.inf("Writing control signal to channel: Ctrl: ", ctrl, ", Orig: ", orig);
 
     if (!this->init) {
         this->logging.err("Failed to write control signal to channel (Instance not initialized)");
@@ -106,22 +195,40 @@ void instance::put_ctrl (double ctrl) {
         throw except_put_ctrl::fail;
     }
 
-    if (ctrl < 0 || ctrl > 1) {
+    if (!this->writer) {
+        this->logging.err("Failed to write control signal to channel (Write access not acquired)");
+        throw except_put_ctrl::fail;
+    }
+
+    if (!instance::check_ctrl(ctrl)) {
         this->logging.err("Failed to write control signal to channel (Invalid control signal)");
         throw except_put_ctrl::fail;
     }
 
-    try {
-        this->ctrl_data.put(ctrl);
-        this->ctrl_drdy.put(true);
-    } catch (...) {
-        this->logging.err("Failed to write control signal to channel");
+    buf[0] = ctrl;
+
+    ret = this->write(this->seg->ctrl, this->seg->ctrl_ring, buf, orig);
+
+    if (ret == status::held) {
+        this->logging.err("Failed to write control signal to channel (Topic held by another writer)");
+        throw except_put_ctrl::fail;
+    }
+
+    if (ret == status::slot) {
+        this->logging.err("Failed to write control signal to channel (History slot held by another writer)");
         throw except_put_ctrl::fail;
     }
 }
 
 void instance::put_stat (const linalg::fvector & stat) {
-    this->logging.inf("Writing state vector to channel: Stat: ", stat);
+    this->put_stat(stat, instance::time_now());
+}
+
+void instance::put_stat (const linalg::fvector & stat, double orig) {
+    double buf[7];
+    status ret;
+
+    this->logging.inf("Writing state vector to channel: Stat: ", stat, ", Orig: ", orig);
 
     if (!this->init) {
         this->logging.err("Failed to write state vector to channel (Instance not initialized)");
@@ -133,32 +240,42 @@ void instance::put_stat (const linalg::fvector & stat) {
         throw except_put_stat::fail;
     }
 
-    if (linalg::dim(stat) != 7) {
-        this->logging.err("Failed to write state vector to channel (Invalid state vector)");
+    if (!this->writer) {
+        this->logging.err("Failed to write state vector to channel (Write access not acquired)");
         throw except_put_stat::fail;
     }
 
-    if (stat[2] < -M_PI || stat[2] > M_PI) {
+    if (!instance::check_stat(stat)) {
         this->logging.err("Failed to write state vector to channel (Invalid state vector)");
         throw except_put_stat::fail;
     }
 
-    if (stat[6] < 0 || stat[6] > 1) {
-        this->logging.err("Failed to write state vector to channel (Invalid state vector)");
+    for (int i = 0; i < 7; i++) {
+        buf[i] = stat[i];
+    }
+
+    ret = this->write(this->seg->stat, this->seg->stat_ring, buf, orig);
+
+    if (ret == status::held) {
+        this->logging.err("Failed to write state vector to channel (Topic held by another writer)");
         throw except_put_stat::fail;
     }
 
-    try {
-        this->stat_data.put(stat);
-        this->stat_drdy.put(true);
-    } catch (...) {
-        this->logging.err("Failed to write state vector to channel");
+    if (ret == status::slot) {
+        this->logging.err("Failed to write state vector to channel (History slot held by another writer)");
         throw except_put_stat::fail;
     }
 }
 
 void instance::put_estm (const linalg::fvector & estm) {
-    this->logging.inf("Writing estimate vector to channel: Estm: ", estm);
+    this->put_estm(estm, instance::time_now());
+}
+
+void instance::put_estm (const linalg::fvector & estm, double orig) {
+    double buf[4];
+    status ret;
+
+    this->logging.inf("Writing estimate vector to channel: Estm: ", estm, ", Orig: ", orig);
 
     if (!this->init) {
         this->logging.err("Failed to write estimate vector to channel (Instance not initialized)");
@@ -170,27 +287,42 @@ void instance::put_estm (const linalg::fvector & estm) {
         throw except_put_estm::fail;
     }
 
-    if (linalg::dim(estm) != 4) {
-        this->logging.err("Failed to write estimate vector to channel (Invalid estimate vector)");
+    if (!this->writer) {
+        this->logging.err("Failed to write estimate vector to channel (Write access not acquired)");
         throw except_put_estm::fail;
     }
 
-    if (estm[1] < 0 || estm[1] > M_PI) {
+    if (!instance::check_estm(estm)) {
         this->logging.err("Failed to write estimate vector to channel (Invalid estimate vector)");
         throw except_put_estm::fail;
     }
 
-    try {
-        this->estm_data.put(estm);
-        this->estm_drdy.put(true);
-    } catch (...) {
-        this->logging.err("Failed to write estimate vector to channel");
+    for (int i = 0; i < 4; i++) {
+        buf[i] = estm[i];
+    }
+
+    ret = this->write(this->seg->estm, this->seg->estm_ring, buf, orig);
+
+    if (ret == status::held) {
+        this->logging.err("Failed to write estimate vector to channel (Topic held by another writer)");
+        throw except_put_estm::fail;
+    }
+
+    if (ret == status::slot) {
+        this->logging.err("Failed to write estimate vector to channel (History slot held by another writer)");
         throw except_put_estm::fail;
     }
 }
 
 void instance::put_sens (const linalg::fvector & sens) {
-    this->logging.inf("Writing sensing vector to channel: Sens: ", sens);
+    this->put_sens(sens, instance::time_now());
+}
+
+void instance::put_sens (const linalg::fvector & sens, double orig) {
+    double buf[17];
+    status ret;
+
+    this->logging.inf("Writing sensing vector to channel: Sens: ", sens, ", Orig: ", orig);
 
     if (!this->init) {
         this->logging.err("Failed to write sensing vector to channel (Instance not initialized)");
@@ -202,58 +334,41 @@ void instance::put_sens (const linalg::fvector & sens) {
         throw except_put_sens::fail;
     }
 
-    if (linalg::dim(sens) != 17) {
-        this->logging.err("Failed to write sensing vector to channel (Invalid sensing vector)");
-        throw except_put_sens::fail;
-    }
-
-    if (sens[10] <= 0) {
-        this->logging.err("Failed to write sensing vector to channel (Invalid sensing vector)");
-        throw except_put_sens::fail;
-    }
-
-    if (sens[11] <= 0) {
-        this->logging.err("Failed to write sensing vector to channel (Invalid sensing vector)");
-        throw except_put_sens::fail;
-    }
-
-    if (sens[12] <= 0) {
-        this->logging.err("Failed to write sensing vector to channel (Invalid sensing vector)");
+    if (!this->writer) {
+        this->logging.err("Failed to write sensing vector to channel (Write access not acquired)");
         throw except_put_sens::fail;
     }
 
-    if (sens[13] <= 0) {
+    if (!instance::check_sens(sens)) {
         this->logging.err("Failed to write sensing vector to channel (Invalid sensing vector)");
         throw except_put_sens::fail;
     }
 
-    if (sens[14] <= 0) {
-        this->logging.err("Failed to write sensing vector to channel (Invalid sensing vector)");
-        throw except_put_sens::fail;
+    for (int i = 0; i < 17; i++) {
+        buf[i] = sens[i];
     }
 
-    if (sens[15] <= 0) {
-        this->logging.err("Failed to write sensing vector to channel (Invalid sensing vector)");
-        throw except_put_sens::fail;
-    }
+    ret = this->write(this->seg->sens, this->seg->sens_ring, buf, orig);
 
-    if (sens[16] <= 0) {
-        this->logging.err("Failed to write sensing vector to channel (Invalid sensing vector)");
+    if (ret == status::held) {
+        this->logging.err("Failed to write sensing vector to channel (Topic held by another writer)");
         throw except_put_sens::fail;
     }
 
-    try {
-        this->sens_data.put(sens);
-        this->sens_drdy.put(true);
-    } catch (...) {
-        this->logging.err("Failed to write sensing vector to channel");
+    if (ret == status::slot) {
+        this->logging.err("Failed to write sensing vector to channel (History slot held by another writer)");
         throw except_put_sens::fail;
     }
 }
 
 double instance::get_ctrl (void) {
-    bool flag;
-    double ctrl;
+    stamp stamp;
+    return this->get_ctrl(stamp);
+}
+
+double instance::get_ctrl (stamp & stamp) {
+    status ret;
+    double buf[1], ctrl;
 
     this->logging.inf("Reading control signal from channel");
 
@@ -267,33 +382,39 @@ double instance::get_ctrl (void) {
         throw except_get_ctrl::fail;
     }
 
-    try {
-        flag = this->ctrl_drdy.get();
-    } catch (...) {
-        this->logging.err("Failed to read control signal from channel");
+    ret = this->read(this->seg->ctrl, this->seg->ctrl_ring, buf, stamp, this->ctrl_last);
+
+    if (ret == status::held) {
+        this->logging.err("Failed to read control signal from channel (Topic held by writer)");
         throw except_get_ctrl::fail;
     }
 
-    if (!flag) {
+    if (ret == status::torn) {
+        this->logging.err("Failed to read control signal from channel (Retry limit reached)");
+        throw except_get_ctrl::fail;
+    }
+
+    if (ret == status::blank) {
         this->logging.wrn("No control signal in channel");
         throw except_get_ctrl::blank;
     }
 
-    try {
-        ctrl = this->ctrl_data.get();
-    } catch (...) {
-        this->logging.err("Failed to read control signal from channel");
-        throw except_get_ctrl::fail;
-    }
+    ctrl = buf[0];
 
-    this->logging.inf("Read control signal from channel: Ctrl: ", ctrl);
+    this->logging.inf("Read control signal from channel: Ctrl: ", ctrl, ", Seq: ", int(stamp.seq), ", Time: ", stamp.time, ", Orig: ", stamp.orig);
 
     return ctrl;
 }
 
 linalg::fvector instance::get_stat (void) {
-    bool flag;
-    linalg::fvector stat;
+    stamp stamp;
+    return this->get_stat(stamp);
+}
+
+linalg::fvector instance::get_stat (stamp & stamp) {
+    status ret;
+    double buf[7];
+    linalg::fvector stat(7);
 
     this->logging.inf("Reading state vector from channel");
 
@@ -307,33 +428,41 @@ linalg::fvector instance::get_stat (void) {
         throw except_get_stat::fail;
     }
 
-    try {
-        flag = this->stat_drdy.get();
-    } catch (...) {
-        this->logging.err("Failed to read state vector from channel");
+    ret = this->read(this->seg->stat, this->seg->stat_ring, buf, stamp, this->stat_last);
+
+    if (ret == status::held) {
+        this->logging.err("Failed to read state vector from channel (Topic held by writer)");
         throw except_get_stat::fail;
     }
 
-    if (!flag) {
+    if (ret == status::torn) {
+        this->logging.err("Failed to read state vector from channel (Retry limit reached)");
+        throw except_get_stat::fail;
+    }
+
+    if (ret == status::blank) {
         this->logging.wrn("No state vector in channel");
         throw except_get_stat::blank;
     }
 
-    try {
-        stat = this->stat_data.get();
-    } catch (...) {
-        this->logging.err("Failed to read state vector from channel");
-        throw except_get_stat::fail;
+    for (int i = 0; i < 7; i++) {
+        stat[i] = buf[i];
     }
 
-    this->logging.inf("Read state vector from channel: Stat: ", stat);
+    this->logging.inf("Read state vector from channel: Stat: ", stat, ", Seq: ", int(stamp.seq), ", Time: ", stamp.time, ", Orig: ", stamp.orig);
 
     return stat;
 }
 
 linalg::fvector instance::get_estm (void) {
-    bool flag;
-    linalg::fvector estm;
+    stamp stamp;
+    return this->get_estm(stamp);
+}
+
+linalg::fvector instance::get_estm (stamp & stamp) {
+    status ret;
+    double buf[4];
+    linalg::fvector estm(4);
 
     this->logging.inf("Reading estimate vector from channel");
 
@@ -347,33 +476,41 @@ linalg::fvector instance::get_estm (void) {
         throw except_get_estm::fail;
     }
 
-    try {
-        flag = this->estm_drdy.get();
-    } catch (...) {
-        this->logging.err("Failed to read estimate vector from channel");
+    ret = this->read(this->seg->estm, this->seg->estm_ring, buf, stamp, this->estm_last);
+
+    if (ret == status::held) {
+        this->logging.err("Failed to read estimate vector from channel (Topic held by writer)");
         throw except_get_estm::fail;
     }
 
-    if (!flag) {
+    if (ret == status::torn) {
+        this->logging.err("Failed to read estimate vector from channel (Retry limit reached)");
+        throw except_get_estm::fail;
+    }
+
+    if (ret == status::blank) {
         this->logging.wrn("No estimate vector in channel");
         throw except_get_estm::blank;
     }
 
-    try {
-        estm = this->estm_data.get();
-    } catch (...) {
-        this->logging.err("Failed to read estimate vector from channel");
-        throw except_get_estm::fail;
+    for (int i = 0; i < 4; i++) {
+        estm[i] = buf[i];
     }
 
-    this->logging.inf("Read estimate vector from channel: Estm: ", estm);
+    this->logging.inf("Read estimate vector from channel: Estm: ", estm, ", Seq: ", int(stamp.seq), ", Time: ", stamp.time, ", Orig: ", stamp.orig);
 
     return estm;
 }
 
 linalg::fvector instance::get_sens (void) {
-    bool flag;
-    linalg::fvector sens;
+    stamp stamp;
+    return this->get_sens(stamp);
+}
+
+linalg::fvector instance::get_sens (stamp & stamp) {
+    status ret;
+    double buf[17];
+    linalg::fvector sens(17);
 
     this->logging.inf("Reading sensing vector from channel");
 
@@ -387,98 +524,1161 @@ linalg::fvector instance::get_sens (void) {
         throw except_get_sens::fail;
     }
 
-    try {
-        flag = this->sens_drdy.get();
-    } catch (...) {
-        this->logging.err("Failed to read sensing vector from channel");
+    ret = this->read(this->seg->sens, this->seg->sens_ring, buf, stamp, this->sens_last);
+
+    if (ret == status::held) {
+        this->logging.err("Failed to read sensing vector from channel (Topic held by writer)");
         throw except_get_sens::fail;
     }
 
-    if (!flag) {
+    if (ret == status::torn) {
+        this->logging.err("Failed to read sensing vector from channel (Retry limit reached)");
+        throw except_get_sens::fail;
+    }
+
+    if (ret == status::blank) {
         this->logging.wrn("No sensing vector in channel");
         throw except_get_sens::blank;
     }
 
-    try {
-        sens = this->sens_data.get();
-    } catch (...) {
-        this->logging.err("Failed to read sensing vector from channel");
-        throw except_get_sens::fail;
+    for (int i = 0; i < 17; i++) {
+        sens[i] = buf[i];
     }
 
-    this->logging.inf("Read sensing vector from channel: Sens: ", sens);
+    this->logging.inf("Read sensing vector from channel: Sens: ", sens, ", Seq: ", int(stamp.seq), ", Time: ", stamp.time, ", Orig: ", stamp.orig);
 
     return sens;
 }
 
-void instance::clear (void) {
-    this->logging.inf("Clearing channels");
+std::vector<double> instance::drain_ctrl (int & lost) {
+    std::vector<stamp> stamp;
+    return this->drain_ctrl(lost, stamp);
+}
+
+std::vector<double> instance::drain_ctrl (int & lost, std::vector<stamp> & stamp) {
+    std::uint32_t head, seq;
+    struct stamp stmp = {};
+    bool torn;
+    double buf[1];
+    std::vector<double> hist;
+
+    this->logging.inf("Draining control signals from channel");
 
     if (!this->init) {
-        this->logging.err("Failed to clear channels (Instance not initialized)");
-        throw except_clear::fail;
+        this->logging.err("Failed to drain control signals from channel (Instance not initialized)");
+        throw except_drain_ctrl::fail;
     }
 
     if (!this->locked) {
-        this->logging.err("Failed to clear channels (Access not acquired)");
-        throw except_clear::fail;
+        this->logging.err("Failed to drain control signals from channel (Access not acquired)");
+        throw except_drain_ctrl::fail;
     }
 
-    try {
-        this->ctrl_drdy.put(false);
-        this->stat_drdy.put(false);
-        this->estm_drdy.put(false);
-        this->sens_drdy.put(false);
-    } catch (...) {
-        this->logging.err("Failed to clear channels");
-        throw except_clear::fail;
+    lost = 0;
+    stamp.clear();
+
+    this->ctrl_last = this->seg->ctrl.seq.load(std::memory_order_acquire);
+    head = this->seg->ctrl.head.load(std::memory_order_acquire);
+
+    if (head - this->ctrl_curs > instance::ring_size) {
+        lost += head - this->ctrl_curs - instance::ring_size;
+        this->ctrl_curs = head - instance::ring_size;
+    }
+
+    for (; this->ctrl_curs != head; this->ctrl_curs++) {
+        auto & slot = this->seg->ctrl_ring.data[this->ctrl_curs % instance::ring_size];
+
+        torn = true;
+        for (int i = 0; torn && i < instance::retry_limit; i++) {
+            if (!seqlock::read_begin(slot.seq, seq)) {
+                break;
+            }
+
+            stmp = slot.stmp;
+            std::memcpy(buf, slot.data, sizeof(buf));
+
+            torn = seqlock::read_retry(slot.seq, seq);
+        }
+
+        if (torn || stmp.seq != this->ctrl_curs) {
+            lost++;
+        } else {
+            stamp.push_back(stmp);
+            hist.push_back(buf[0]);
+        }
+    }
+
+    if (lost > 0) {
+        this->logging.wrn("Lost control signals in channel: Count: ", lost);
     }
+
+    this->logging.inf("Drained control signals from channel: Count: ", int(hist.size()));
+
+    return hist;
+}
+
+std::vector<linalg::fvector> instance::drain_stat (int & lost) {
+    std::vector<stamp> stamp;
+    return this->drain_stat(lost, stamp);
 }
 
-void instance::acquire (void) {
-    this->logging.inf("Acquiring access");
+std::vector<linalg::fvector> instance::drain_stat (int & lost, std::vector<stamp> & stamp) {
+    std::uint32_t head, seq;
+    struct stamp stmp = {};
+    bool torn;
+    double buf[7];
+    std::vector<linalg::fvector> hist;
+
+    this->logging.inf("Draining state vectors from channel");
 
     if (!this->init) {
-        this->logging.err("Failed to acquire access (Instance not initialized)");
-        throw except_acquire::fail;
+        this->logging.err("Failed to drain state vectors from channel (Instance not initialized)");
+        throw except_drain_stat::fail;
     }
 
-    if (this->locked) {
-        this->logging.err("Failed to acquire access (Access already acquired)");
-        throw except_acquire::fail;
+    if (!this->locked) {
+        this->logging.err("Failed to drain state vectors from channel (Access not acquired)");
+        throw except_drain_stat::fail;
     }
 
-    try {
-        this->acces.acquire();
-    } catch (...) {
-        this->logging.err("Failed to acquire access");
-        throw except_acquire::fail;
+    lost = 0;
+    stamp.clear();
+
+    this->stat_last = this->seg->stat.seq.load(std::memory_order_acquire);
+    head = this->seg->stat.head.load(std::memory_order_acquire);
+
+    if (head - this->stat_curs > instance::ring_size) {
+        lost += head - this->stat_curs - instance::ring_size;
+        this->stat_curs = head - instance::ring_size;
     }
 
-    this->locked = true;
+    for (; this->stat_curs != head; this->stat_curs++) {
+        auto & slot = this->seg->stat_ring.data[this->stat_curs % instance::ring_size];
+
+        torn = true;
+        for (int i = 0; torn && i < instance::retry_limit; i++) {
+            if (!seqlock::read_begin(slot.seq, seq)) {
+                break;
+            }
+
+            stmp = slot.stmp;
+            std::memcpy(buf, slot.data, sizeof(buf));
+
+            torn = seqlock::read_retry(slot.seq, seq);
+        }
+
+        if (torn || stmp.seq != this->stat_curs) {
+            lost++;
+        } else {
+            stamp.push_back(stmp);
+            hist.push_back(linalg::fvector(7));
+            for (int j = 0; j < 7; j++) {
+                hist.back()[j] = buf[j];
+            }
+        }
+    }
+
+    if (lost > 0) {
+        this->logging.wrn("Lost state vectors in channel: Count: ", lost);
+    }
+
+    this->logging.inf("Drained state vectors from channel: Count: ", int(hist.size()));
+
+    return hist;
 }
 
-void instance::release (void) {
-    this->logging.inf("Releasing access");
+std::vector<linalg::fvector> instance::drain_estm (int & lost) {
+    std::vector<stamp> stamp;
+    return this->drain_estm(lost, stamp);
+}
+
+std::vector<linalg::fvector> instance::drain_estm (int & lost, std::vector<stamp> & stamp) {
+    std::uint32_t head, seq;
+    struct stamp stmp = {};
+    bool torn;
+    double buf[4];
+    std::vector<linalg::fvector> hist;
+
+    this->logging.inf("Draining estimate vectors from channel");
 
     if (!this->init) {
-        this->logging.err("Failed to release access (Instance not initialized)");
-        throw except_release::fail;
+        this->logging.err("Failed to drain estimate vectors from channel (Instance not initialized)");
+        throw except_drain_estm::fail;
     }
 
     if (!this->locked) {
-        this->logging.err("Failed to release access (Access already released)");
-        throw except_release::fail;
+        this->logging.err("Failed to drain estimate vectors from channel (Access not acquired)");
+        throw except_drain_estm::fail;
     }
 
-    try {
-        this->acces.release();
-    } catch (...) {
-        this->logging.err("Failed to release access");
-        throw except_release::fail;
+    lost = 0;
+    stamp.clear();
+
+    this->estm_last = this->seg->estm.seq.load(std::memory_order_acquire);
+    head = this->seg->estm.head.load(std::memory_order_acquire);
+
+    if (head - this->estm_curs > instance::ring_size) {
+        lost += head - this->estm_curs - instance::ring_size;
+        this->estm_curs = head - instance::ring_size;
     }
 
-    this->locked = false;
+    for (; this->estm_curs != head; this->estm_curs++) {
+        auto & slot = this->seg->estm_ring.data[this->estm_curs % instance::ring_size];
+
+        torn = true;
+        for (int i = 0; torn && i < instance::retry_limit; i++) {
+            if (!seqlock::read_begin(slot.seq, seq)) {
+                break;
+            }
+
+            stmp = slot.stmp;
+            std::memcpy(buf, slot.data, sizeof(buf));
+
+            torn = seqlock::read_retry(slot.seq, seq);
+        }
+
+        if (torn || stmp.seq != this->estm_curs) {
+            lost++;
+        } else {
+            stamp.push_back(stmp);
+            hist.push_back(linalg::fvector(4));
+            for (int j = 0; j < 4; j++) {
+                hist.back()[j] = buf[j];
+            }
+        }
+    }
+
+    if (lost > 0) {
+        this->logging.wrn("Lost estimate vectors in channel: Count: ", lost);
+    }
+
+    this->logging.inf("Drained estimate vectors from channel: Count: ", int(hist.size()));
+
+    return hist;
+}
+
+std::vector<linalg::fvector> instance::drain_sens (int & lost) {
+    std::vector<stamp> stamp;
+    return this->drain_sens(lost, stamp);
+}
+
+std::vector<linalg::fvector> instance::drain_sens (int & lost, std::vector<stamp> & stamp) {
+    std::uint32_t head, seq;
+    struct stamp stmp = {};
+    bool torn;
+    double buf[17];
+    std::vector<linalg::fvector> hist;
+
+    this->logging.inf("Draining sensing vectors from channel");
+
+    if (!this->init) {
+        this->logging.err("Failed to drain sensing vectors from channel (Instance not initialized)");
+        throw except_drain_sens::fail;
+    }
+
+    if (!this->locked) {
+        this->logging.err("Failed to drain sensing vectors from channel (Access not acquired)");
+        throw except_drain_sens::fail;
+    }
+
+    lost = 0;
+    stamp.clear();
+
+    this->sens_last = this->seg->sens.seq.load(std::memory_order_acquire);
+    head = this->seg->sens.head.load(std::memory_order_acquire);
+
+    if (head - this->sens_curs > instance::ring_size) {
+        lost += head - this->sens_curs - instance::ring_size;
+        this->sens_curs = head - instance::ring_size;
+    }
+
+    for (; this->sens_curs != head; this->sens_curs++) {
+        auto & slot = this->seg->sens_ring.data[this->sens_curs % instance::ring_size];
+
+        torn = true;
+        for (int i = 0; torn && i < instance::retry_limit; i++) {
+            if (!seqlock::read_begin(slot.seq, seq)) {
+                break;
+            }
+
+            stmp = slot.stmp;
+            std::memcpy(buf, slot.data, sizeof(buf));
+
+            torn = seqlock::read_retry(slot.seq, seq);
+        }
+
+        if (torn || stmp.seq != this->sens_curs) {
+            lost++;
+        } else {
+            stamp.push_back(stmp);
+            hist.push_back(linalg::fvector(17));
+            for (int j = 0; j < 17; j++) {
+                hist.back()[j] = buf[j];
+            }
+        }
+    }
+
+    if (lost > 0) {
+        this->logging.wrn("Lost sensing vectors in channel: Count: ", lost);
+    }
+
+    this->logging.inf("Drained sensing vectors from channel: Count: ", int(hist.size()));
+
+    return hist;
+}
+
+void instance::transact (batch & batch) {
+    this->transact(batch, instance::time_now());
+}
+
+void instance::transact (batch & batch, double orig) {
+    double ctrl_buf[1], stat_buf[7], estm_buf[4], sens_buf[17];
+    std::uint32_t ctrl_seq, stat_seq, estm_seq, sens_seq;
+    bool torn = true;
+    status ret;
+
+    this->logging.inf(
+        "Transacting with channel: Put: [", batch.ctrl_put, ", ", batch.stat_put, ", ", batch.estm_put, ", ", batch.sens_put,
+        "], Get: [", batch.ctrl_get, ", ", batch.stat_get, ", ", batch.estm_get, ", ", batch.sens_get, "], Orig: ", orig
+    );
+
+    if (!this->init) {
+        this->logging.err("Failed to transact with channel (Instance not initialized)");
+        throw except_transact::fail;
+    }
+
+    if (!this->locked) {
+        this->logging.err("Failed to transact with channel (Access not acquired)");
+        throw except_transact::fail;
+    }
+
+    if (!this->writer && (batch.ctrl_put || batch.stat_put || batch.estm_put || batch.sens_put)) {
+        this->logging.err("Failed to transact with channel (Write access not acquired)");
+        throw except_transact::fail;
+    }
+
+    if (batch.ctrl_put && !instance::check_ctrl(batch.ctrl)) {
+        this->logging.err("Failed to transact with channel (Invalid control signal)");
+        throw except_transact::fail;
+    }
+
+    if (batch.stat_put && !instance::check_stat(batch.stat)) {
+        this->logging.err("Failed to transact with channel (Invalid state vector)");
+        throw except_transact::fail;
+    }
+
+    if (batch.estm_put && !instance::check_estm(batch.estm)) {
+        this->logging.err("Failed to transact with channel (Invalid estimate vector)");
+        throw except_transact::fail;
+    }
+
+    if (batch.sens_put && !instance::check_sens(batch.sens)) {
+        this->logging.err("Failed to transact with channel (Invalid sensing vector)");
+        throw except_transact::fail;
+    }
+
+    if (batch.ctrl_put) {
+        ret = this->write_lock(this->seg->ctrl, this->seg->ctrl_ring);
+
+        if (ret == status::held) {
+            this->logging.err("Failed to transact with channel (Control signal topic held by another writer)");
+            throw except_transact::fail;
+        }
+
+        if (ret == status::slot) {
+            this->logging.err("Failed to transact with channel (Control signal history slot held by another writer)");
+            throw except_transact::fail;
+        }
+    }
+
+    if (batch.stat_put) {
+        ret = this->write_lock(this->seg->stat, this->seg->stat_ring);
+
+        if (ret != status::done) {
+            if (batch.ctrl_put) {
+                this->write_abort(this->seg->ctrl, this->seg->ctrl_ring);
+            }
+        }
+
+        if (ret == status::held) {
+            this->logging.err("Failed to transact with channel (State vector topic held by another writer)");
+            throw except_transact::fail;
+        }
+
+        if (ret == status::slot) {
+            this->logging.err("Failed to transact with channel (State vector history slot held by another writer)");
+            throw except_transact::fail;
+        }
+    }
+
+    if (batch.estm_put) {
+        ret = this->write_lock(this->seg->estm, this->seg->estm_ring);
+
+        if (ret != status::done) {
+            if (batch.ctrl_put) {
+                this->write_abort(this->seg->ctrl, this->seg->ctrl_ring);
+            }
+
+            if (batch.stat_put) {
+                this->write_abort(this->seg->stat, this->seg->stat_ring);
+            }
+        }
+
+        if (ret == status::held) {
+            this->logging.err("Failed to transact with channel (Estimate vector topic held by another writer)");
+            throw except_transact::fail;
+        }
+
+        if (ret == status::slot) {
+            this->logging.err("Failed to transact with channel (Estimate vector history slot held by another writer)");
+            throw except_transact::fail;
+        }
+    }
+
+    if (batch.sens_put) {
+        ret = this->write_lock(this->seg->sens, this->seg->sens_ring);
+
+        if (ret != status::done) {
+            if (batch.ctrl_put) {
+                this->write_abort(this->seg->ctrl, this->seg->ctrl_ring);
+            }
+
+            if (batch.stat_put) {
+                this->write_abort(this->seg->stat, this->seg->stat_ring);
+            }
+
+            if (batch.estm_put) {
+                this->write_abort(this->seg->estm, this->seg->estm_ring);
+            }
+        }
+
+        if (ret == status::held) {
+            this->logging.err("Failed to transact with channel (Sensing vector topic held by another writer)");
+            throw except_transact::fail;
+        }
+
+        if (ret == status::slot) {
+            this->logging.err("Failed to transact with channel (Sensing vector history slot held by another writer)");
+            throw except_transact::fail;
+        }
+    }
+
+    if (batch.ctrl_put) {
+        ctrl_buf[0] = batch.ctrl;
+        this->write_data(this->seg->ctrl, this->seg->ctrl_ring, ctrl_buf, orig);
+    }
+
+    if (batch.stat_put) {
+        for (int i = 0; i < 7; i++) {
+            stat_buf[i] = batch.stat[i];
+        }
+
+        this->write_data(this->seg->stat, this->seg->stat_ring, stat_buf, orig);
+    }
+
+    if (batch.estm_put) {
+        for (int i = 0; i < 4; i++) {
+            estm_buf[i] = batch.estm[i];
+        }
+
+        this->write_data(this->seg->estm, this->seg->estm_ring, estm_buf, orig);
+    }
+
+    if (batch.sens_put) {
+        for (int i = 0; i < 17; i++) {
+            sens_buf[i] = batch.sens[i];
+        }
+
+        this->write_data(this->seg->sens, this->seg->sens_ring, sens_buf, orig);
+    }
+
+    if (batch.ctrl_put) {
+        this->write_unlock(this->seg->ctrl, this->seg->ctrl_ring);
+    }
+
+    if (batch.stat_put) {
+        this->write_unlock(this->seg->stat, this->seg->stat_ring);
+    }
+
+    if (batch.estm_put) {
+        this->write_unlock(this->seg->estm, this->seg->estm_ring);
+    }
+
+    if (batch.sens_put) {
+        this->write_unlock(this->seg->sens, this->seg->sens_ring);
+    }
+
+    for (int i = 0; torn && i < instance::retry_limit; i++) {
+        if (batch.ctrl_get) {
+            ret = this->read(this->seg->ctrl, this->seg->ctrl_ring, ctrl_buf, batch.ctrl_stmp, ctrl_seq);
+
+            if (ret == status::held) {
+                this->logging.err("Failed to transact with channel (Control signal topic held by writer)");
+                throw except_transact::fail;
+            }
+
+            if (ret == status::torn) {
+                this->logging.err("Failed to transact with channel (Control signal retry limit reached)");
+                throw except_transact::fail;
+            }
+
+            batch.ctrl_drdy = (ret == status::done);
+        }
+
+        if (batch.stat_get) {
+            ret = this->read(this->seg->stat, this->seg->stat_ring, stat_buf, batch.stat_stmp, stat_seq);
+
+            if (ret == status::held) {
+                this->logging.err("Failed to transact with channel (State vector topic held by writer)");
+                throw except_transact::fail;
+            }
+
+            if (ret == status::torn) {
+                this->logging.err("Failed to transact with channel (State vector retry limit reached)");
+                throw except_transact::fail;
+            }
+
+            batch.stat_drdy = (ret == status::done);
+        }
+
+        if (batch.estm_get) {
+            ret = this->read(this->seg->estm, this->seg->estm_ring, estm_buf, batch.estm_stmp, estm_seq);
+
+            if (ret == status::held) {
+                this->logging.err("Failed to transact with channel (Estimate vector topic held by writer)");
+                throw except_transact::fail;
+            }
+
+            if (ret == status::torn) {
+                this->logging.err("Failed to transact with channel (Estimate vector retry limit reached)");
+                throw except_transact::fail;
+            }
+
+            batch.estm_drdy = (ret == status::done);
+        }
+
+        if (batch.sens_get) {
+            ret = this->read(this->seg->sens, this->seg->sens_ring, sens_buf, batch.sens_stmp, sens_seq);
+
+            if (ret == status::held) {
+                this->logging.err("Failed to transact with channel (Sensing vector topic held by writer)");
+                throw except_transact::fail;
+            }
+
+            if (ret == status::torn) {
+                this->logging.err("Failed to transact with channel (Sensing vector retry limit reached)");
+                throw except_transact::fail;
+            }
+
+            batch.sens_drdy = (ret == status::done);
+        }
+
+        torn = (batch.ctrl_get && seqlock::read_retry(this->seg->ctrl.seq, ctrl_seq))
+            || (batch.stat_get && seqlock::read_retry(this->seg->stat.seq, stat_seq))
+            || (batch.estm_get && seqlock::read_retry(this->seg->estm.seq, estm_seq))
+            || (batch.sens_get && seqlock::read_retry(this->seg->sens.seq, sens_seq));
+    }
+
+    if (torn) {
+        this->logging.err("Failed to transact with channel (Snapshot retry limit reached)");
+        throw except_transact::fail;
+    }
+
+    if (batch.ctrl_get) {
+        this->ctrl_last = ctrl_seq;
+
+        if (batch.ctrl_drdy) {
+            batch.ctrl = ctrl_buf[0];
+        }
+    }
+
+    if (batch.stat_get) {
+        this->stat_last = stat_seq;
+
+        if (batch.stat_drdy) {
+            batch.stat = linalg::fvector(7);
+            for (int i = 0; i < 7; i++) {
+                batch.stat[i] = stat_buf[i];
+            }
+        }
+    }
+
+    if (batch.estm_get) {
+        this->estm_last = estm_seq;
+
+        if (batch.estm_drdy) {
+            batch.estm = linalg::fvector(4);
+            for (int i = 0; i < 4; i++) {
+                batch.estm[i] = estm_buf[i];
+            }
+        }
+    }
+
+    if (batch.sens_get) {
+        this->sens_last = sens_seq;
+
+        if (batch.sens_drdy) {
+            batch.sens = linalg::fvector(17);
+            for (int i = 0; i < 17; i++) {
+                batch.sens[i] = sens_buf[i];
+            }
+        }
+    }
+
+    this->logging.inf("Transacted with channel");
+}
+
+void instance::wait_ctrl (double dur) {
+    this->logging.inf("Waiting for control signal in channel: Dur: ", dur);
+
+    if (!this->init) {
+        this->logging.err("Failed to wait for control signal in channel (Instance not initialized)");
+        throw except_wait_ctrl::fail;
+    }
+
+    if (this->locked) {
+        this->logging.err("Failed to wait for control signal in channel (Access acquired)");
+        throw except_wait_ctrl::fail;
+    }
+
+    if (dur < 0) {
+        this->logging.err("Failed to wait for control signal in channel (Invalid duration)");
+        throw except_wait_ctrl::fail;
+    }
+
+    if (!seqlock::wait(this->seg->ctrl.seq, this->seg->ctrl.wait, this->ctrl_last, dur)) {
+        this->logging.wrn("No new control signal in channel");
+        throw except_wait_ctrl::timeout;
+    }
+}
+
+void instance::wait_stat (double dur) {
+    this->logging.inf("Waiting for state vector in channel: Dur: ", dur);
+
+    if (!this->init) {
+        this->logging.err("Failed to wait for state vector in channel (Instance not initialized)");
+        throw except_wait_stat::fail;
+    }
+
+    if (this->locked) {
+        this->logging.err("Failed to wait for state vector in channel (Access acquired)");
+        throw except_wait_stat::fail;
+    }
+
+    if (dur < 0) {
+        this->logging.err("Failed to wait for state vector in channel (Invalid duration)");
+        throw except_wait_stat::fail;
+    }
+
+    if (!seqlock::wait(this->seg->stat.seq, this->seg->stat.wait, this->stat_last, dur)) {
+        this->logging.wrn("No new state vector in channel");
+        throw except_wait_stat::timeout;
+    }
+}
+
+void instance::wait_estm (double dur) {
+    this->logging.inf("Waiting for estimate vector in channel: Dur: ", dur);
+
+    if (!this->init) {
+        this->logging.err("Failed to wait for estimate vector in channel (Instance not initialized)");
+        throw except_wait_estm::fail;
+    }
+
+    if (this->locked) {
+        this->logging.err("Failed to wait for estimate vector in channel (Access acquired)");
+        throw except_wait_estm::fail;
+    }
+
+    if (dur < 0) {
+        this->logging.err("Failed to wait for estimate vector in channel (Invalid duration)");
+        throw except_wait_estm::fail;
+    }
+
+    if (!seqlock::wait(this->seg->estm.seq, this->seg->estm.wait, this->estm_last, dur)) {
+        this->logging.wrn("No new estimate vector in channel");
+        throw except_wait_estm::timeout;
+    }
+}
+
+void instance::wait_sens (double dur) {
+    this->logging.inf("Waiting for sensing vector in channel: Dur: ", dur);
+
+    if (!this->init) {
+        this->logging.err("Failed to wait for sensing vector in channel (Instance not initialized)");
+        throw except_wait_sens::fail;
+    }
+
+    if (this->locked) {
+        this->logging.err("Failed to wait for sensing vector in channel (Access acquired)");
+        throw except_wait_sens::fail;
+    }
+
+    if (dur < 0) {
+        this->logging.err("Failed to wait for sensing vector in channel (Invalid duration)");
+        throw except_wait_sens::fail;
+    }
+
+    if (!seqlock::wait(this->seg->sens.seq, this->seg->sens.wait, this->sens_last, dur)) {
+        this->logging.wrn("No new sensing vector in channel");
+        throw except_wait_sens::timeout;
+    }
+}
+
+void instance::clear (void) {
+    this->logging.inf("Clearing channels");
+
+    if (!this->init) {
+        this->logging.err("Failed to clear channels (Instance not initialized)");
+        throw except_clear::fail;
+    }
+
+    if (!this->locked) {
+        this->logging.err("Failed to clear channels (Access not acquired)");
+        throw except_clear::fail;
+    }
+
+    if (!this->writer) {
+        this->logging.err("Failed to clear channels (Write access not acquired)");
+        throw except_clear::fail;
+    }
+
+    if (!seqlock::write_begin(this->seg->ctrl.seq)) {
+        this->logging.err("Failed to clear channels (Topic held by another writer)");
+        throw except_clear::fail;
+    }
+
+    this->seg->ctrl.drdy = false;
+
+    seqlock::write_end(this->seg->ctrl.seq);
+
+    if (!seqlock::write_begin(this->seg->stat.seq)) {
+        this->logging.err("Failed to clear channels (Topic held by another writer)");
+        throw except_clear::fail;
+    }
+
+    this->seg->stat.drdy = false;
+
+    seqlock::write_end(this->seg->stat.seq);
+
+    if (!seqlock::write_begin(this->seg->estm.seq)) {
+        this->logging.err("Failed to clear channels (Topic held by another writer)");
+        throw except_clear::fail;
+    }
+
+    this->seg->estm.drdy = false;
+
+    seqlock::write_end(this->seg->estm.seq);
+
+    if (!seqlock::write_begin(this->seg->sens.seq)) {
+        this->logging.err("Failed to clear channels (Topic held by another writer)");
+        throw except_clear::fail;
+    }
+
+    this->seg->sens.drdy = false;
+
+    seqlock::write_end(this->seg->sens.seq);
+}
+
+void instance::set_sync (sync sync) {
+    int ret;
+
+    this->logging.inf(
+        "Setting synchronization: Sync: ", (sync == sync::free) ? "Lock-free" : (sync == sync::prio) ? "Priority lock" : "Lock"
+    );
+
+    if (!this->init) {
+        this->logging.err("Failed to set synchronization (Instance not initialized)");
+        throw except_set_sync::fail;
+    }
+
+    if (!this->locked) {
+        this->logging.err("Failed to set synchronization (Access not acquired)");
+        throw except_set_sync::fail;
+    }
+
+    if (!this->writer) {
+        this->logging.err("Failed to set synchronization (Write access not acquired)");
+        throw except_set_sync::fail;
+    }
+
+    if (sync == sync::prio && this->seg->disc.load(std::memory_order_acquire) != sync::prio) {
+        ret = this->mutx_init(true);
+        if (ret == ENOTSUP) {
+            this->logging.wrn("Priority inheritance not supported, using robust mutex without it");
+            ret = this->mutx_init(false);
+        }
+        if (ret != 0) {
+            this->logging.err("Failed to set synchronization (", std::strerror(ret), ")");
+            throw except_set_sync::fail;
+        }
+    }
+
+    this->seg->disc.store(sync, std::memory_order_release);
+}
+
+int instance::mutx_init (bool prio) {
+    pthread_mutexattr_t attr;
+    int ret;
+
+    this->logging.inf("Initializing access mutex: Priority inheritance: ", prio);
+
+    ret = pthread_mutexattr_init(&attr);
+    if (ret != 0) {
+        return ret;
+    }
+
+    ret = pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+    if (ret == 0) {
+        ret = pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+    }
+    if (ret == 0 && prio) {
+        ret = pthread_mutexattr_setprotocol(&attr, PTHREAD_PRIO_INHERIT);
+    }
+    if (ret == 0) {
+        ret = pthread_mutex_init(&this->seg->mutx, &attr);
+    }
+
+    pthread_mutexattr_destroy(&attr);
+
+    return ret;
+}
+
+bool instance::check_ctrl (double ctrl) {
+    if (ctrl < 0 || ctrl > 1) {
+        return false;
+    }
+
+    return true;
+}
+
+bool instance::check_stat (const linalg::fvector & stat) {
+    if (linalg::dim(stat) != 7) {
+        return false;
+    }
+
+    if (stat[2] < -M_PI || stat[2] > M_PI) {
+        return false;
+    }
+
+    if (stat[6] < 0 || stat[6] > 1) {
+        return false;
+    }
+
+    return true;
+}
+
+bool instance::check_estm (const linalg::fvector & estm) {
+    if (linalg::dim(estm) != 4) {
+        return false;
+    }
+
+    if (estm[1] < 0 || estm[1] > M_PI) {
+        return false;
+    }
+
+    return true;
+}
+
+bool instance::check_sens (const linalg::fvector & sens) {
+    if (linalg::dim(sens) != 17) {
+        return false;
+    }
+
+    if (sens[10] <= 0) {
+        return false;
+    }
+
+    if (sens[11] <= 0) {
+        return false;
+    }
+
+    if (sens[12] <= 0) {
+        return false;
+    }
+
+    if (sens[13] <= 0) {
+        return false;
+    }
+
+    if (sens[14] <= 0) {
+        return false;
+    }
+
+    if (sens[15] <= 0) {
+        return false;
+    }
+
+    if (sens[16] <= 0) {
+        return false;
+    }
+
+    return true;
+}
+
+template <int dim>
+instance::status instance::write (topic<dim> & topic, ring<dim> & ring, const double * data, double orig) {
+    status ret;
+
+    ret = this->write_lock(topic, ring);
+    if (ret != status::done) {
+        return ret;
+    }
+
+    this->write_data(topic, ring, data, orig);
+    this->write_unlock(topic, ring);
+
+    return status::done;
+}
+
+template <int dim>
+instance::status instance::write_lock (topic<dim> & topic, ring<dim> & ring) {
+    std::uint32_t head, self = getpid();
+
+    if (!seqlock::claim(topic.ownr, self)) {
+        if (!this->recover(topic, ring) || !seqlock::claim(topic.ownr, self)) {
+            return status::held;
+        }
+    }
+
+    if (!seqlock::write_begin(topic.seq)) {
+        seqlock::leave(topic.ownr);
+        return status::held;
+    }
+
+    head = topic.head.load(std::memory_order_relaxed);
+    auto & slot = ring.data[head % instance::ring_size];
+
+    if (!seqlock::write_begin(slot.seq)) {
+        seqlock::write_end(topic.seq);
+        seqlock::leave(topic.ownr);
+        return status::slot;
+    }
+
+    return status::done;
+}
+
+template <int dim>
+void instance::write_data (topic<dim> & topic, ring<dim> & ring, const double * data, double orig) {
+    std::uint32_t head;
+
+    head = topic.head.load(std::memory_order_relaxed);
+    auto & slot = ring.data[head % instance::ring_size];
+
+    std::memcpy(topic.data, data, sizeof(topic.data));
+    topic.drdy = true;
+    topic.stmp.seq = head;
+    topic.stmp.time = instance::time_now();
+    topic.stmp.orig = orig;
+
+    slot.stmp = topic.stmp;
+    std::memcpy(slot.data, topic.data, sizeof(slot.data));
+}
+
+template <int dim>
+void instance::write_unlock (topic<dim> & topic, ring<dim> & ring) {
+    std::uint32_t head;
+
+    head = topic.head.load(std::memory_order_relaxed);
+    auto & slot = ring.data[head % instance::ring_size];
+
+    seqlock::write_end(slot.seq);
+
+    topic.head.store(head + 1, std::memory_order_release);
+
+    seqlock::write_end(topic.seq);
+    seqlock::leave(topic.ownr);
+    seqlock::wake(topic.seq, topic.wait);
+}
+
+template <int dim>
+void instance::write_abort (topic<dim> & topic, ring<dim> & ring) {
+    std::uint32_t head;
+
+    head = topic.head.load(std::memory_order_relaxed);
+    auto & slot = ring.data[head % instance::ring_size];
+
+    seqlock::write_end(slot.seq);
+    seqlock::write_end(topic.seq);
+    seqlock::leave(topic.ownr);
+}
+
+template <int dim>
+instance::status instance::read (topic<dim> & topic, ring<dim> & ring, double * data, stamp & stamp, std::uint32_t & last) {
+    std::uint32_t seq;
+    bool flag = false, torn = true;
+
+    for (int i = 0; torn && i < instance::retry_limit; i++) {
+        if (!seqlock::read_begin(topic.seq, seq)) {
+            if (!this->recover(topic, ring) || !seqlock::read_begin(topic.seq, seq)) {
+                return status::held;
+            }
+        }
+
+        flag = topic.drdy;
+        if (flag) {
+            stamp = topic.stmp;
+            std::memcpy(data, topic.data, sizeof(topic.data));
+        }
+
+        torn = seqlock::read_retry(topic.seq, seq);
+    }
+
+    if (torn) {
+        return status::torn;
+    }
+
+    last = seq;
+
+    if (!flag) {
+        return status::blank;
+    }
+
+    return status::done;
+}
+
+double instance::time_now (void) {
+    timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+void instance::acquire (role role) {
+    sync disc;
+    int ret;
+
+    this->logging.inf("Acquiring access: Role: ", (role == role::writer) ? "Writer" : "Reader");
+
+    if (!this->init) {
+        this->logging.err("Failed to acquire access (Instance not initialized)");
+        throw except_acquire::fail;
+    }
+
+    if (this->locked) {
+        this->logging.err("Failed to acquire access (Access already acquired)");
+        throw except_acquire::fail;
+    }
+
+    disc = this->seg->disc.load(std::memory_order_acquire);
+
+    if (disc == sync::lock) {
+        try {
+            this->acces.acquire();
+        } catch (...) {
+            this->logging.err("Failed to acquire access");
+            throw except_acquire::fail;
+        }
+
+        this->held = true;
+    }
+
+    if (disc == sync::prio && role == role::writer) {
+        ret = pthread_mutex_lock(&this->seg->mutx);
+        if (ret == EOWNERDEAD) {
+            this->logging.wrn("Recovering access from terminated owner");
+            this->repair();
+            ret = pthread_mutex_consistent(&this->seg->mutx);
+        }
+        if (ret != 0) {
+            this->logging.err("Failed to acquire access (", std::strerror(ret), ")");
+            throw except_acquire::fail;
+        }
+
+        this->owned = true;
+    }
+
+    this->locked = true;
+    this->writer = (role == role::writer);
+}
+
+void instance::release (void) {
+    int ret;
+
+    this->logging.inf("Releasing access");
+
+    if (!this->init) {
+        this->logging.err("Failed to release access (Instance not initialized)");
+        throw except_release::fail;
+    }
+
+    if (!this->locked) {
+        this->logging.err("Failed to release access (Access already released)");
+        throw except_release::fail;
+    }
+
+    if (this->owned) {
+        ret = pthread_mutex_unlock(&this->seg->mutx);
+        if (ret != 0) {
+            this->logging.err("Failed to release access (", std::strerror(ret), ")");
+            throw except_release::fail;
+        }
+
+        this->owned = false;
+    }
+
+    if (this->held) {
+        try {
+            this->acces.release();
+        } catch (...) {
+            this->logging.err("Failed to release access");
+            throw except_release::fail;
+        }
+
+        this->held = false;
+    }
+
+    this->locked = false;
+    this->writer = false;
+}
+
+template <int dim>
+void instance::repair (topic<dim> & topic, ring<dim> & ring) {
+    std::uint32_t head;
+
+    head = topic.head.load(std::memory_order_relaxed);
+    auto & slot = ring.data[head % instance::ring_size];
+
+    if (topic.seq.load(std::memory_order_relaxed) % 2 != 0) {
+        topic.drdy = false;
+        seqlock::repair(topic.seq);
+    }
+
+    if (slot.seq.load(std::memory_order_relaxed) % 2 != 0) {
+        slot.stmp.seq = head + 1;
+        seqlock::repair(slot.seq);
+    }
+
+    seqlock::leave(topic.ownr);
+    seqlock::wake(topic.seq, topic.wait);
+}
+
+template <int dim>
+bool instance::recover (topic<dim> & topic, ring<dim> & ring) {
+    std::uint32_t ownr;
+
+    ownr = topic.ownr.load(std::memory_order_acquire);
+    if (ownr == 0 || kill(ownr, 0) == 0 || errno != ESRCH) {
+        return false;
+    }
+
+    if (!topic.ownr.compare_exchange_strong(ownr, getpid(), std::memory_order_acquire, std::memory_order_relaxed)) {
+        return false;
+    }
+
+    this->logging.wrn("Recovering topic from terminated writer: PID: ", int(ownr));
+    this->repair(topic, ring);
+
+    return true;
+}
+
+void instance::repair (void) {
+    this->logging.wrn("Repairing sequence counters");
+
+    this->repair(this->seg->ctrl, this->seg->ctrl_ring);
+    this->repair(this->seg->stat, this->seg->stat_ring);
+    this->repair(this->seg->estm, this->seg->estm_ring);
+    this->repair(this->seg->sens, this->seg->sens_ring);
 }
 
 }
@@ -0,0 +1,138 @@
+#include <cstdint>
+#include <climits>
+#include <ctime>
+
+#include <atomic>
+#include <thread>
+
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+#include <ipc/seqlock.hpp>
+
+namespace seqlock {
+
+static_assert(counter::is_always_lock_free);
+static_assert(sizeof(counter) == sizeof(std::uint32_t));
+
+static const int spin_limit = 4096;
+
+bool write_begin (counter & seq) {
+    std::uint32_t val;
+
+    for (int i = 0; ; i++) {
+        val = seq.load(std::memory_order_relaxed);
+        if (val % 2 == 0 && seq.compare_exchange_weak(val, val + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+            break;
+        }
+
+        if (i == spin_limit) {
+            return false;
+        }
+
+        std::this_thread::yield();
+    }
+
+    std::atomic_thread_fence(std::memory_order_release);
+
+    return true;
+}
+
+void write_end (counter & seq) {
+    seq.fetch_add(1, std::memory_order_release);
+}
+
+void repair (counter & seq) {
+    std::uint32_t val;
+
+    val = seq.load(std::memory_order_relaxed);
+    if (val % 2 != 0) {
+        seq.compare_exchange_strong(val, val + 1, std::memory_order_release, std::memory_order_relaxed);
+    }
+}
+
+bool claim (counter & own, std::uint32_t val) {
+    std::uint32_t none;
+
+    for (int i = 0; ; i++) {
+        none = 0;
+        if (own.compare_exchange_weak(none, val, std::memory_order_acquire, std::memory_order_relaxed)) {
+            return true;
+        }
+
+        if (i == spin_limit) {
+            return false;
+        }
+
+        std::this_thread::yield();
+    }
+}
+
+void leave (counter & own) {
+    own.store(0, std::memory_order_release);
+}
+
+bool read_begin (const counter & seq, std::uint32_t & val) {
+    for (int i = 0; ; i++) {
+        val = seq.load(std::memory_order_acquire);
+        if (val % 2 == 0) {
+            return true;
+        }
+
+        if (i == spin_limit) {
+            return false;
+        }
+
+        std::this_thread::yield();
+    }
+}
+
+bool read_retry (const counter & seq, std::uint32_t val) {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return seq.load(std::memory_order_relaxed) != val;
+}
+
+bool wait (counter & seq, counter & cnt, std::uint32_t val, double dur) {
+    std::uint32_t cur;
+    double rem;
+    timespec strt, now, tout;
+    bool done = false;
+
+    clock_gettime(CLOCK_MONOTONIC, &strt);
+
+    cnt.fetch_add(1, std::memory_order_seq_cst);
+
+    while (true) {
+        cur = seq.load(std::memory_order_seq_cst);
+        if (cur != val && cur % 2 == 0) {
+            done = true;
+            break;
+        }
+
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        rem = dur - (now.tv_sec - strt.tv_sec) - (now.tv_nsec - strt.tv_nsec) * 1e-9;
+        if (rem <= 0) {
+            break;
+        }
+
+        tout.tv_sec = (time_t)rem;
+        tout.tv_nsec = (long)((rem - tout.tv_sec) * 1e9);
+
+        syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(&seq), FUTEX_WAIT, cur, &tout, NULL, 0);
+    }
+
+    cnt.fetch_sub(1, std::memory_order_relaxed);
+
+    return done;
+}
+
+void wake (counter & seq, counter & cnt) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (cnt.load(std::memory_order_relaxed) > 0) {
+        syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(&seq), FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+    }
+}
+
+}
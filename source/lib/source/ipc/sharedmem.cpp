@@ -24,290 +24,6 @@ int tracker::instantiate (void) {
     return tracker::count;
 }
 
-instance<std::uint8_t>::instance (const std::string & name, mode mode)
-  : logging("sharedmem"), init(false), id(instance<std::uint8_t>::instantiate()), name(name), len(sizeof(std::uint8_t)),
-    create(mode == mode::create || mode == mode::both), remove(mode == mode::remove || mode == mode::both) {
-
-    bool obj_open = false, obj_map = false;
-    int ret, desc;
-
-    this->logging.inf("Initializing instance #", this->id, ": Type: Byte, Name: ", this->name);
-
-    try {
-        this->logging.inf("Opening shared memory object #", this->id);
-        if (this->create) {
-            desc = shm_open(this->name.c_str(), O_RDWR | O_CREAT, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH);
-        } else {
-            desc = shm_open(this->name.c_str(), O_RDWR, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH);
-        }
-        if (desc < 0) {
-            this->logging.err("Failed to open shared memory object #", this->id, " (", std::strerror(errno), ")");
-            throw except_intern{};
-        }
-
-        obj_open = true;
-
-        this->logging.inf("Resizing shared memory object #", this->id);
-        ret = ftruncate(desc, this->len);
-        if (ret < 0) {
-            this->logging.err("Failed to resize shared memory object #", this->id, " (", std::strerror(errno), ")");
-            throw except_intern{};
-        }
-
-        this->logging.inf("Mapping shared memory region #", this->id);
-        this->data = (std::uint8_t *)mmap(NULL, this->len, PROT_READ | PROT_WRITE, MAP_SHARED, desc, 0);
-        if (this->data == MAP_FAILED) {
-            this->logging.err("Failed to map shared memory region #", this->id, " (", std::strerror(errno), ")");
-            throw except_intern{};
-        }
-
-        obj_map = true;
-
-        obj_open = false;
-
-        this->logging.inf("Closing shared memory object #", this->id);
-        ret = close(desc);
-        if (ret < 0) {
-            this->logging.err("Failed to close shared memory object #", this->id, " (", std::strerror(errno), ")");
-            throw except_intern{};
-        }
-    } catch (except_intern) {
-        if (obj_open) {
-            this->logging.wrn("Closing shared memory object #", this->id);
-            ret = close(desc);
-            if (ret < 0) {
-                this->logging.err("Failed to close shared memory object #", this->id, " (", std::strerror(errno), ")");
-            }
-        }
-
-        if (obj_map) {
-            this->logging.wrn("Unmapping shared memory region #", this->id);
-            ret = munmap(this->data, this->len);
-            if (ret < 0) {
-                this->logging.err("Failed to unmap shared memory region #", this->id, " (", std::strerror(errno), ")");
-            }
-        }
-
-        this->logging.err("Failed to initialize instance #", this->id);
-        throw except_ctor::fail;
-    }
-
-    this->init = true;
-}
-
-instance<bool>::instance (const std::string & name, mode mode)
-  : logging("sharedmem"), init(false), id(instance<bool>::instantiate()), name(name), len(sizeof(bool)),
-    create(mode == mode::create || mode == mode::both), remove(mode == mode::remove || mode == mode::both) {
-
-    bool obj_open = false, obj_map = false;
-    int ret, desc;
-
-    this->logging.inf("Initializing instance #", this->id, ": Type: Boolean, Name: ", this->name);
-
-    try {
-        this->logging.inf("Opening shared memory object #", this->id);
-        if (this->create) {
-            desc = shm_open(this->name.c_str(), O_RDWR | O_CREAT, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH);
-        } else {
-            desc = shm_open(this->name.c_str(), O_RDWR, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH);
-        }
-        if (desc < 0) {
-            this->logging.err("Failed to open shared memory object #", this->id, " (", std::strerror(errno), ")");
-            throw except_intern{};
-        }
-
-        obj_open = true;
-
-        this->logging.inf("Resizing shared memory object #", this->id);
-        ret = ftruncate(desc, this->len);
-        if (ret < 0) {
-            this->logging.err("Failed to resize shared memory object #", this->id, " (", std::strerror(errno), ")");
-            throw except_intern{};
-        }
-
-        this->logging.inf("Mapping shared memory region #", this->id);
-        this->data = (bool *)mmap(NULL, this->len, PROT_READ | PROT_WRITE, MAP_SHARED, desc, 0);
-        if (this->data == MAP_FAILED) {
-            this->logging.err("Failed to map shared memory region #", this->id, " (", std::strerror(errno), ")");
-            throw except_intern{};
-        }
-
-        obj_map = true;
-
-        obj_open = false;
-
-        this->logging.inf("Closing shared memory object #", this->id);
-        ret = close(desc);
-        if (ret < 0) {
-            this->logging.err("Failed to close shared memory object #", this->id, " (", std::strerror(errno), ")");
-            throw except_intern{};
-        }
-    } catch (except_intern) {
-        if (obj_open) {
-            this->logging.wrn("Closing shared memory object #", this->id);
-            ret = close(desc);
-            if (ret < 0) {
-                this->logging.err("Failed to close shared memory object #", this->id, " (", std::strerror(errno), ")");
-            }
-        }
-
-        if (obj_map) {
-            this->logging.wrn("Unmapping shared memory region #", this->id);
-            ret = munmap(this->data, this->len);
-            if (ret < 0) {
-                this->logging.err("Failed to unmap shared memory region #", this->id, " (", std::strerror(errno), ")");
-            }
-        }
-
-        this->logging.err("Failed to initialize instance #", this->id);
-        throw except_ctor::fail;
-    }
-
-    this->init = true;
-}
-
-instance<int>::instance (const std::string & name, mode mode)
-  : logging("sharedmem"), init(false), id(instance<int>::instantiate()), name(name), len(sizeof(int)),
-    create(mode == mode::create || mode == mode::both), remove(mode == mode::remove || mode == mode::both) {
-
-    bool obj_open = false, obj_map = false;
-    int ret, desc;
-
-    this->logging.inf("Initializing instance #", this->id, ": Type: Integer scalar, Name: ", this->name);
-
-    try {
-        this->logging.inf("Opening shared memory object #", this->id);
-        if (this->create) {
-            desc = shm_open(this->name.c_str(), O_RDWR | O_CREAT, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH);
-        } else {
-            desc = shm_open(this->name.c_str(), O_RDWR, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH);
-        }
-        if (desc < 0) {
-            this->logging.err("Failed to open shared memory object #", this->id, " (", std::strerror(errno), ")");
-            throw except_intern{};
-        }
-
-        obj_open = true;
-
-        this->logging.inf("Resizing shared memory object #", this->id);
-        ret = ftruncate(desc, this->len);
-        if (ret < 0) {
-            this->logging.err("Failed to resize shared memory object #", this->id, " (", std::strerror(errno), ")");
-            throw except_intern{};
-        }
-
-        this->logging.inf("Mapping shared memory region #", this->id);
-        this->data = (int *)mmap(NULL, this->len, PROT_READ | PROT_WRITE, MAP_SHARED, desc, 0);
-        if (this->data == MAP_FAILED) {
-            this->logging.err("Failed to map shared memory region #", this->id, " (", std::strerror(errno), ")");
-            throw except_intern{};
-        }
-
-        obj_map = true;
-
-        obj_open = false;
-
-        this->logging.inf("Closing shared memory object #", this->id);
-        ret = close(desc);
-        if (ret < 0) {
-            this->logging.err("Failed to close shared memory object #", this->id, " (", std::strerror(errno), ")");
-            throw except_intern{};
-        }
-    } catch (except_intern) {
-        if (obj_open) {
-            this->logging.wrn("Closing shared memory object #", this->id);
-            ret = close(desc);
-            if (ret < 0) {
-                this->logging.err("Failed to close shared memory object #", this->id, " (", std::strerror(errno), ")");
-            }
-        }
-
-        if (obj_map) {
-            this->logging.wrn("Unmapping shared memory region #", this->id);
-            ret = munmap(this->data, this->len);
-            if (ret < 0) {
-                this->logging.err("Failed to unmap shared memory region #", this->id, " (", std::strerror(errno), ")");
-            }
-        }
-
-        this->logging.err("Failed to initialize instance #", this->id);
-        throw except_ctor::fail;
-    }
-
-    this->init = true;
-}
-
-instance<double>::instance (const std::string & name, mode mode)
-  : logging("sharedmem"), init(false), id(instance<double>::instantiate()), name(name), len(sizeof(double)),
-    create(mode == mode::create || mode == mode::both), remove(mode == mode::remove || mode == mode::both) {
-
-    bool obj_open = false, obj_map = false;
-    int ret, desc;
-
-    this->logging.inf("Initializing instance #", this->id, ": Type: Real scalar, Name: ", this->name);
-
-    try {
-        this->logging.inf("Opening shared memory object #", this->id);
-        if (this->create) {
-            desc = shm_open(this->name.c_str(), O_RDWR | O_CREAT, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH);
-        } else {
-            desc = shm_open(this->name.c_str(), O_RDWR, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH);
-        }
-        if (desc < 0) {
-            this->logging.err("Failed to open shared memory object #", this->id, " (", std::strerror(errno), ")");
-            throw except_intern{};
-        }
-
-        obj_open = true;
-
-        this->logging.inf("Resizing shared memory object #", this->id);
-        ret = ftruncate(desc, this->len);
-        if (ret < 0) {
-            this->logging.err("Failed to resize shared memory object #", this->id, " (", std::strerror(errno), ")");
-            throw except_intern{};
-        }
-
-        this->logging.inf("Mapping shared memory region #", this->id);
-        this->data = (double *)mmap(NULL, this->len, PROT_READ | PROT_WRITE, MAP_SHARED, desc, 0);
-        if (this->data == MAP_FAILED) {
-            this->logging.err("Failed to map shared memory region #", this->id, " (", std::strerror(errno), ")");
-            throw except_intern{};
-        }
-
-        obj_map = true;
-
-        obj_open = false;
-
-        this->logging.inf("Closing shared memory object #", this->id);
-        ret = close(desc);
-        if (ret < 0) {
-            this->logging.err("Failed to close shared memory object #", this->id, " (", std::strerror(errno), ")");
-            throw except_intern{};
-        }
-    } catch (except_intern) {
-        if (obj_open) {
-            this->logging.wrn("Closing shared memory object #", this->id);
-            ret = close(desc);
-            if (ret < 0) {
-                this->logging.err("Failed to close shared memory object #", this->id, " (", std::strerror(errno), ")");
-            }
-        }
-
-        if (obj_map) {
-            this->logging.wrn("Unmapping shared memory region #", this->id);
-            ret = munmap(this->data, this->len);
-            if (ret < 0) {
-                this->logging.err("Failed to unmap shared memory region #", this->id, " (", std::strerror(errno), ")");
-            }
-        }
-
-        this->logging.err("Failed to initialize instance #", this->id);
-        throw except_ctor::fail;
-    }
-
-    this->init = true;
-}
-
 instance<linalg::ivector>::instance (const std::string & name, int dim, mode mode)
   : logging("sharedmem"), init(false), id(instance<linalg::ivector>::instantiate()), name(name), len(dim * sizeof(int)), dim(dim),
     create(mode == mode::create || mode == mode::both), remove(mode == mode::remove || mode == mode::both) {
@@ -618,86 +334,6 @@ instance<linalg::fmatrix>::instance (const std::string & name, int rows, int col
     this->init = true;
 }
 
-instance<std::uint8_t>::~instance (void) {
-    int ret;
-
-    if (this->init) {
-        this->logging.inf("Unmapping shared memory region #", this->id);
-        ret = munmap(this->data, this->len);
-        if (ret < 0) {
-            this->logging.err("Failed to unmap shared memory region #", this->id, " (", std::strerror(errno), ")");
-        }
-
-        if (this->remove) {
-            this->logging.inf("Unlinking shared memory object #", this->id);
-            ret = shm_unlink(this->name.c_str());
-            if (ret < 0) {
-                this->logging.err("Failed to unlink shared memory object #", this->id, " (", std::strerror(errno), ")");
-            }
-        }
-    }
-}
-
-instance<bool>::~instance (void) {
-    int ret;
-
-    if (this->init) {
-        this->logging.inf("Unmapping shared memory region #", this->id);
-        ret = munmap(this->data, this->len);
-        if (ret < 0) {
-            this->logging.err("Failed to unmap shared memory region #", this->id, " (", std::strerror(errno), ")");
-        }
-
-        if (this->remove) {
-            this->logging.inf("Unlinking shared memory object #", this->id);
-            ret = shm_unlink(this->name.c_str());
-            if (ret < 0) {
-                this->logging.err("Failed to unlink shared memory object #", this->id, " (", std::strerror(errno), ")");
-            }
-        }
-    }
-}
-
-instance<int>::~instance (void) {
-    int ret;
-
-    if (this->init) {
-        this->logging.inf("Unmapping shared memory region #", this->id);
-        ret = munmap(this->data, this->len);
-        if (ret < 0) {
-            this->logging.err("Failed to unmap shared memory region #", this->id, " (", std::strerror(errno), ")");
-        }
-
-        if (this->remove) {
-            this->logging.inf("Unlinking shared memory object #", this->id);
-            ret = shm_unlink(this->name.c_str());
-            if (ret < 0) {
-                this->logging.err("Failed to unlink shared memory object #", this->id, " (", std::strerror(errno), ")");
-            }
-        }
-    }
-}
-
-instance<double>::~instance (void) {
-    int ret;
-
-    if (this->init) {
-        this->logging.inf("Unmapping shared memory region #", this->id);
-        ret = munmap(this->data, this->len);
-        if (ret < 0) {
-            this->logging.err("Failed to unmap shared memory region #", this->id, " (", std::strerror(errno), ")");
-        }
-
-        if (this->remove) {
-            this->logging.inf("Unlinking shared memory object #", this->id);
-            ret = shm_unlink(this->name.c_str());
-            if (ret < 0) {
-                this->logging.err("Failed to unlink shared memory object #", this->id, " (", std::strerror(errno), ")");
-            }
-        }
-    }
-}
-
 instance<linalg::ivector>::~instance (void) {
     int ret;
 
@@ -778,50 +414,6 @@ instance<linalg::fmatrix>::~instance (void) {
     }
 }
 
-void instance<std::uint8_t>::put (std::uint8_t val) {
-    this->logging.inf("Writing data to shared memory region #", this->id, ": Type: Byte, Value: ", val);
-
-    if (!this->init) {
-        this->logging.err("Failed to write data to shared memory region #", this->id, " (Instance not initialized)");
-        throw except_put::fail;
-    }
-
-    *(this->data) = val;
-}
-
-void instance<bool>::put (bool val) {
-    this->logging.inf("Writing data to shared memory region #", this->id, ": Type: Boolean, Value: ", val);
-
-    if (!this->init) {
-        this->logging.err("Failed to write data to shared memory region #", this->id, " (Instance not initialized)");
-        throw except_put::fail;
-    }
-
-    *(this->data) = val;
-}
-
-void instance<int>::put (int val) {
-    this->logging.inf("Writing data to shared memory region #", this->id, ": Type: Integer scalar, Value: ", val);
-
-    if (!this->init) {
-        this->logging.err("Failed to write data to shared memory region #", this->id, " (Instance not initialized)");
-        throw except_put::fail;
-    }
-
-    *(this->data) = val;
-}
-
-void instance<double>::put (double val) {
-    this->logging.inf("Writing data to shared memory region #", this->id, ": Type: Real scalar, Value: ", val);
-
-    if (!this->init) {
-        this->logging.err("Failed to write data to shared memory region #", this->id, " (Instance not initialized)");
-        throw except_put::fail;
-    }
-
-    *(this->data) = val;
-}
-
 void instance<linalg::ivector>::put (const linalg::ivector & val) {
     this->logging.inf("Writing data to shared memory region #", this->id, ": Type: Integer vector, Value: ", val);
 
@@ -898,70 +490,6 @@ void instance<linalg::fmatrix>::put (const linalg::fmatrix & val) {
     }
 }
 
-std::uint8_t instance<std::uint8_t>::get (void) {
-    std::uint8_t val;
-
-    this->logging.inf("Reading data from shared memory region #", this->id, ": Type: Byte");
-
-    if (!this->init) {
-        this->logging.err("Failed to read data from shared memory region #", this->id, " (Instance not initialized)");
-        throw except_get::fail;
-    }
-
-    val = *(this->data);
-    this->logging.inf("Read data from shared memory region #", this->id, ": Value: ", val);
-
-    return val;
-}
-
-bool instance<bool>::get (void) {
-    bool val;
-
-    this->logging.inf("Reading data from shared memory region #", this->id, ": Type: Boolean");
-
-    if (!this->init) {
-        this->logging.err("Failed to read data from shared memory region #", this->id, " (Instance not initialized)");
-        throw except_get::fail;
-    }
-
-    val = *(this->data);
-    this->logging.inf("Read data from shared memory region #", this->id, ": Value: ", val);
-
-    return val;
-}
-
-int instance<int>::get (void) {
-    int val;
-
-    this->logging.inf("Reading data from shared memory region #", this->id, ": Type: Integer scalar");
-
-    if (!this->init) {
-        this->logging.err("Failed to read data from shared memory region #", this->id, " (Instance not initialized)");
-        throw except_get::fail;
-    }
-
-    val = *(this->data);
-    this->logging.inf("Read data from shared memory region #", this->id, ": Value: ", val);
-
-    return val;
-}
-
-double instance<double>::get (void) {
-    double val;
-
-    this->logging.inf("Reading data from shared memory region #", this->id, ": Type: Real scalar");
-
-    if (!this->init) {
-        this->logging.err("Failed to read data from shared memory region #", this->id, " (Instance not initialized)");
-        throw except_get::fail;
-    }
-
-    val = *(this->data);
-    this->logging.inf("Read data from shared memory region #", this->id, ": Value: ", val);
-
-    return val;
-}
-
 linalg::ivector instance<linalg::ivector>::get (void) {
     linalg::ivector val;
 
@@ -1050,4 +578,92 @@ linalg::fmatrix instance<linalg::fmatrix>::get (void) {
     return val;
 }
 
+vecview<int> instance<linalg::ivector>::put_view (void) {
+    this->logging.inf("Exposing shared memory region #", this->id, " for writing: Type: Integer vector");
+
+    if (!this->init) {
+        this->logging.err("Failed to expose shared memory region #", this->id, " for writing (Instance not initialized)");
+        throw except_put_view::fail;
+    }
+
+    return vecview<int>(this->data, this->dim);
+}
+
+vecview<double> instance<linalg::fvector>::put_view (void) {
+    this->logging.inf("Exposing shared memory region #", this->id, " for writing: Type: Real vector");
+
+    if (!this->init) {
+        this->logging.err("Failed to expose shared memory region #", this->id, " for writing (Instance not initialized)");
+        throw except_put_view::fail;
+    }
+
+    return vecview<double>(this->data, this->dim);
+}
+
+matview<int> instance<linalg::imatrix>::put_view (void) {
+    this->logging.inf("Exposing shared memory region #", this->id, " for writing: Type: Integer matrix");
+
+    if (!this->init) {
+        this->logging.err("Failed to expose shared memory region #", this->id, " for writing (Instance not initialized)");
+        throw except_put_view::fail;
+    }
+
+    return matview<int>(this->data, this->rows, this->cols);
+}
+
+matview<double> instance<linalg::fmatrix>::put_view (void) {
+    this->logging.inf("Exposing shared memory region #", this->id, " for writing: Type: Real matrix");
+
+    if (!this->init) {
+        this->logging.err("Failed to expose shared memory region #", this->id, " for writing (Instance not initialized)");
+        throw except_put_view::fail;
+    }
+
+    return matview<double>(this->data, this->rows, this->cols);
+}
+
+vecview<const int> instance<linalg::ivector>::get_view (void) {
+    this->logging.inf("Exposing shared memory region #", this->id, " for reading: Type: Integer vector");
+
+    if (!this->init) {
+        this->logging.err("Failed to expose shared memory region #", this->id, " for reading (Instance not initialized)");
+        throw except_get_view::fail;
+    }
+
+    return vecview<const int>(this->data, this->dim);
+}
+
+vecview<const double> instance<linalg::fvector>::get_view (void) {
+    this->logging.inf("Exposing shared memory region #", this->id, " for reading: Type: Real vector");
+
+    if (!this->init) {
+        this->logging.err("Failed to expose shared memory region #", this->id, " for reading (Instance not initialized)");
+        throw except_get_view::fail;
+    }
+
+    return vecview<const double>(this->data, this->dim);
+}
+
+matview<const int> instance<linalg::imatrix>::get_view (void) {
+    this->logging.inf("Exposing shared memory region #", this->id, " for reading: Type: Integer matrix");
+
+    if (!this->init) {
+        this->logging.err("Failed to expose shared memory region #", this->id, " for reading (Instance not initialized)");
+        throw except_get_view::fail;
+    }
+
+    return matview<const int>(this->data, this->rows, this->cols);
+}
+
+matview<const double> instance<linalg::fmatrix>::get_view (void) {
+    this->logging.inf("Exposing shared memory region #", this->id, " for reading: Type: Real matrix");
+
+    if (!this->init) {
+        this->logging.err("Failed to expose shared memory region #", this->id, " for reading (Instance not initialized)");
+        throw except_get_view::fail;
+    }
+
+    return matview<const double>(this->data, this->rows, this->cols);
+}
+
 }
@@ -0,0 +1,86 @@
+#include <cmath>
+
+#include <iterator>
+#include <algorithm>
+#include <vector>
+
+#include <math/lookup.hpp>
+
+namespace lookup {
+
+double step (const std::vector<double> & node) {
+    double step, tol;
+    int size;
+
+    size = node.size();
+
+    if (size < 2) {
+        return 0;
+    }
+
+    step = (node.back() - node.front()) / (size - 1);
+    tol = 1e-9 * std::fabs(node.back() - node.front());
+
+    if (!(step > 0)) {
+        return 0;
+    }
+
+    for (int i = 1; i < size; i++) {
+        if (std::fabs(node[i] - (node.front() + i * step)) > tol) {
+            return 0;
+        }
+    }
+
+    return step;
+}
+
+int find (const std::vector<double> & node, double step, double val, int & hint) {
+    int size, idx, lowr, uppr, incr;
+
+    size = node.size();
+
+    if (val < node.front()) {
+        idx = 0;
+    } else if (val >= node.back()) {
+        idx = size - 2;
+    } else if (step > 0) {
+        idx = int((val - node.front()) / step);
+        if (idx > size - 2) {
+            idx = size - 2;
+        }
+        while (idx > 0 && val < node[idx]) {
+            idx--;
+        }
+        while (idx < size - 2 && val >= node[idx + 1]) {
+            idx++;
+        }
+    } else {
+        lowr = std::min(std::max(hint, 0), size - 2);
+        incr = 1;
+
+        if (val >= node[lowr]) {
+            uppr = lowr + 1;
+            while (uppr < size - 1 && val >= node[uppr]) {
+                lowr = uppr;
+                uppr = std::min(uppr + incr, size - 1);
+                incr *= 2;
+            }
+        } else {
+            uppr = lowr;
+            lowr = uppr - 1;
+            while (lowr > 0 && val < node[lowr]) {
+                uppr = lowr;
+                lowr = std::max(lowr - incr, 0);
+                incr *= 2;
+            }
+        }
+
+        idx = std::distance(node.begin(), std::upper_bound(node.begin() + lowr, node.begin() + uppr + 1, val)) - 1;
+    }
+
+    hint = idx;
+
+    return idx;
+}
+
+}
@@ -1,16 +1,26 @@
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 
+#include <atomic>
 #include <iomanip>
 #include <iostream>
 #include <fstream>
+#include <map>
+#include <sstream>
 #include <chrono>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include <unistd.h>
 #include <fcntl.h>
+#include <pthread.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/file.h>
 
 #include <math/linalg.hpp>
 #include <sys/logging.hpp>
@@ -20,27 +30,80 @@ namespace logging {
 bool instance::init = false;
 int instance::desc;
 std::ofstream instance::file;
+std::string instance::bin;
+std::string instance::path;
 std::string instance::app;
-stream instance::strm(instance::file);
+mode instance::layout = mode::shared;
 
-bool instance::start (const std::string & path, const std::string & app) {
+instance::cell instance::ring[instance::ring_size];
+std::atomic<std::uint64_t> instance::ring_head(0);
+std::uint64_t instance::ring_tail = 0;
+std::atomic<int> instance::drop(0);
+
+std::atomic<bool> instance::run(false);
+std::thread * instance::thrd = nullptr;
+std::mutex instance::mutx;
+bool instance::hook = false;
+bool instance::fresh = false;
+std::unordered_map<std::string, std::uint32_t> instance::strs;
+
+std::mutex instance::thrs_mutx;
+instance::level instance::thrs_base = level::inf;
+
+instance::site instance::sites[instance::site_count];
+std::atomic<int> instance::rate(0);
+std::atomic<int> instance::ratio(1);
+std::int64_t instance::last = 0;
+
+origin::origin (const char * text, const char * file, int line)
+  : text(text), key((static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(file)) << 16) | static_cast<std::uint16_t>(line)) {}
+
+bool instance::start (const std::string & path, const std::string & app, mode mode) {
     if (instance::init) {
         return false;
     }
 
-    instance::file.clear();
-    instance::file.open(path, std::ios::app);
-    if (instance::file.fail()) {
+    instance::path = path;
+    instance::app = app;
+    instance::layout = mode;
+
+    if (!instance::attach()) {
         return false;
     }
 
-    instance::desc = open(path.c_str(), O_RDONLY);
-    if (instance::desc < 0) {
-        instance::file.close();
-        return false;
+    for (std::uint64_t i = 0; i < instance::ring_size; i++) {
+        instance::ring[i].seq.store(i, std::memory_order_relaxed);
     }
+    instance::ring_head.store(0, std::memory_order_relaxed);
+    instance::ring_tail = 0;
+    instance::drop.store(0, std::memory_order_relaxed);
 
-    instance::app = app;
+    instance::strs.clear();
+    instance::fresh = true;
+
+    for (auto & elem : instance::sites) {
+        elem.supp.store(0, std::memory_order_relaxed);
+    }
+    instance::last = std::chrono::steady_clock::now().time_since_epoch().count();
+
+    if (!instance::hook) {
+        if (pthread_atfork(instance::prepare, instance::parent, instance::child) != 0) {
+            instance::detach();
+            return false;
+        }
+
+        instance::hook = true;
+    }
+
+    instance::run.store(true, std::memory_order_release);
+
+    try {
+        instance::thrd = new std::thread(instance::drain);
+    } catch (...) {
+        instance::run.store(false, std::memory_order_release);
+        instance::detach();
+        return false;
+    }
 
     instance::init = true;
 
@@ -52,52 +115,670 @@ void instance::stop (void) {
         return;
     }
 
+    instance::init = false;
+
+    instance::run.store(false, std::memory_order_release);
+    instance::thrd->join();
+    delete instance::thrd;
+    instance::thrd = nullptr;
+
+    instance::mutx.lock();
+    instance::flush();
+    instance::mutx.unlock();
+
+    instance::detach();
+}
+
+bool instance::filter (const std::vector<std::string> & levs) {
+    std::map<std::string, level> over;
+    level base = level::inf, lev;
+
+    for (auto & str : levs) {
+        auto pos = str.find(':');
+        if (pos == std::string::npos) {
+            return false;
+        }
+
+        if (!instance::parse(str.substr(pos + 1), lev)) {
+            return false;
+        }
+
+        if (str.substr(0, pos) == "*") {
+            base = lev;
+        } else {
+            over[str.substr(0, pos)] = lev;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(instance::thrs_mutx);
+
+    instance::thrs_base = base;
+    instance::thrs_over() = over;
+
+    for (auto & [lib, thrs] : instance::thrs_libs()) {
+        auto itr = over.find(lib);
+        thrs.store(itr == over.end() ? base : itr->second, std::memory_order_relaxed);
+    }
+
+    return true;
+}
+
+instance::instance (const std::string & lib) : lib(lib) {
+    std::lock_guard<std::mutex> lock(instance::thrs_mutx);
+
+    auto itr = instance::thrs_libs().find(lib);
+    if (itr == instance::thrs_libs().end()) {
+        auto & thrs = instance::thrs_libs()[lib];
+        auto over = instance::thrs_over().find(lib);
+        thrs.store(over == instance::thrs_over().end() ? instance::thrs_base : over->second, std::memory_order_relaxed);
+        itr = instance::thrs_libs().find(lib);
+    }
+
+    this->thrs = &itr->second;
+    this->name = &itr->first;
+}
+
+bool instance::limit (int rate, int ratio) {
+    if (rate < 0 || ratio < 1) {
+        return false;
+    }
+
+    instance::rate.store(rate, std::memory_order_relaxed);
+    instance::ratio.store(ratio, std::memory_order_relaxed);
+
+    return true;
+}
+
+std::map<std::string, std::atomic<instance::level>> & instance::thrs_libs (void) {
+    static std::map<std::string, std::atomic<level>> libs;
+    return libs;
+}
+
+std::map<std::string, instance::level> & instance::thrs_over (void) {
+    static std::map<std::string, level> over;
+    return over;
+}
+
+bool instance::parse (const std::string & str, level & lev) {
+    if (str == "inf") {
+        lev = level::inf;
+    } else if (str == "wrn") {
+        lev = level::wrn;
+    } else if (str == "err") {
+        lev = level::err;
+    } else {
+        return false;
+    }
+
+    return true;
+}
+
+bool instance::admit (std::uint64_t key, std::int64_t time, const char * text) {
+    int rate = instance::rate.load(std::memory_order_relaxed);
+    int ratio = instance::ratio.load(std::memory_order_relaxed);
+    std::int64_t slot = time / instance::report_period, prev;
+    std::uint64_t none, hash = (key * 0x9E3779B97F4A7C15) >> 32;
+    site * site = nullptr;
+
+    if (rate == 0 && ratio == 1) {
+        return true;
+    }
+
+    for (std::size_t i = 0; i < instance::site_count; i++) {
+        auto & elem = instance::sites[(hash + i) % instance::site_count];
+
+        none = 0;
+        if (elem.key.load(std::memory_order_acquire) == key) {
+            site = &elem;
+            break;
+        }
+        if (elem.key.compare_exchange_strong(none, key, std::memory_order_acq_rel)) {
+            std::strncpy(elem.text, text, instance::text_size - 1);
+            elem.text[instance::text_size - 1] = '\0';
+            elem.lib.store(this->name, std::memory_order_release);
+            site = &elem;
+            break;
+        }
+        if (none == key) {
+            site = &elem;
+            break;
+        }
+    }
+
+    if (site == nullptr) {
+        return true;
+    }
+
+    if (site->hits.fetch_add(1, std::memory_order_relaxed) % ratio != 0) {
+        site->supp.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    if (rate > 0) {
+        prev = site->slot.load(std::memory_order_relaxed);
+        if (prev != slot && site->slot.compare_exchange_strong(prev, slot, std::memory_order_relaxed)) {
+            site->pass.store(0, std::memory_order_relaxed);
+        }
+
+        if (site->pass.fetch_add(1, std::memory_order_relaxed) >= rate) {
+            site->supp.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+instance::cell * instance::claim (void) {
+    std::uint64_t pos, seq;
+    cell * cell;
+
+    pos = instance::ring_head.load(std::memory_order_relaxed);
+
+    while (true) {
+        cell = &instance::ring[pos % instance::ring_size];
+        seq = cell->seq.load(std::memory_order_acquire);
+
+        if (seq == pos) {
+            if (instance::ring_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                return cell;
+            }
+        } else if (seq < pos) {
+            instance::drop.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        } else {
+            pos = instance::ring_head.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void instance::commit (cell * cell, std::size_t len) {
+    cell->len = len;
+    cell->seq.store(cell->seq.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+void instance::drain (void) {
+    bool done;
+
+    while (instance::run.load(std::memory_order_acquire)) {
+        instance::mutx.lock();
+        done = instance::flush();
+        instance::mutx.unlock();
+
+        if (!done) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(instance::drain_period));
+        }
+    }
+}
+
+bool instance::flush (void) {
+    std::uint64_t count = 0;
+    std::uint32_t head[3];
+    std::int64_t time;
+    std::string line;
+    int lost;
+
+    instance::bin.clear();
+
+    time = std::chrono::steady_clock::now().time_since_epoch().count();
+
+    if (instance::fresh) {
+        instance::entry(record::kind::proc, instance::app);
+        instance::fresh = false;
+    }
+
+    lost = instance::drop.exchange(0, std::memory_order_relaxed);
+    if (lost > 0) {
+        line.append(reinterpret_cast<const char *>(&time), sizeof(time));
+        line.append(reinterpret_cast<const char *>(&lost), sizeof(lost));
+        instance::entry(record::kind::drop, line);
+    }
+
+    if (time - instance::last >= instance::report_period || !instance::run.load(std::memory_order_acquire)) {
+        instance::report(time);
+        instance::last = time;
+    }
+
+    while (count < instance::ring_size) {
+        cell & cell = instance::ring[instance::ring_tail % instance::ring_size];
+
+        if (cell.seq.load(std::memory_order_acquire) != instance::ring_tail + 1) {
+            break;
+        }
+
+        instance::encode(cell.data, cell.len);
+
+        cell.seq.store(instance::ring_tail + instance::ring_size, std::memory_order_release);
+        instance::ring_tail++;
+        count++;
+    }
+
+    if (instance::bin.empty()) {
+        return false;
+    }
+
+    head[0] = record::magic;
+    head[1] = getpid();
+    head[2] = instance::bin.size();
+
+    if (instance::layout == mode::shared && flock(instance::desc, LOCK_EX) < 0) {
+        instance::strs.clear();
+        instance::fresh = true;
+        return true;
+    }
+
+    instance::file.write(reinterpret_cast<const char *>(head), sizeof(head));
+    instance::file.write(instance::bin.data(), instance::bin.size());
+    instance::file.flush();
+
+    if (instance::layout == mode::shared) {
+        flock(instance::desc, LOCK_UN);
+    }
+
+    return true;
+}
+
+void instance::report (std::int64_t time) {
+    static char data[cell_size];
+    const std::string * lib;
+    int supp;
+
+    for (auto & elem : instance::sites) {
+        lib = elem.lib.load(std::memory_order_acquire);
+        if (lib == nullptr) {
+            continue;
+        }
+
+        supp = elem.supp.exchange(0, std::memory_order_relaxed);
+        if (supp == 0) {
+            continue;
+        }
+
+        record rec(data, instance::cell_size);
+
+        rec.put_head(time, elem.key.load(std::memory_order_relaxed), static_cast<std::uint8_t>(level::inf), *lib);
+        rec.put("Suppressed ");
+        rec.put(supp);
+        rec.put(" messages like ");
+        rec.put(std::string(elem.text));
+
+        instance::encode(data, rec.seal());
+    }
+}
+
+void instance::encode (const char * data, std::size_t len) {
+    std::size_t pos = 0, hlen = sizeof(std::int64_t) + sizeof(std::uint64_t) + sizeof(std::uint8_t);
+    std::uint32_t sid;
+    std::string line;
+    int size;
+
+    line.append(data + pos, hlen);
+    pos += hlen;
+
+    std::memcpy(&size, data + pos, sizeof(size));
+    pos += sizeof(size);
+
+    sid = instance::intern(std::string(data + pos, size));
+    pos += size;
+    line.append(reinterpret_cast<const char *>(&sid), sizeof(sid));
+
+    while (pos < len) {
+        pos = instance::field(data, pos, len, line);
+    }
+
+    instance::entry(record::kind::line, line);
+}
+
+std::size_t instance::field (const char * data, std::size_t pos, std::size_t len, std::string & line) {
+    record::tag tag;
+    std::uint32_t sid;
+    int size, rows, cols;
+
+    tag = static_cast<record::tag>(data[pos]);
+
+    if (tag == record::tag::chr) {
+        pos++;
+        std::memcpy(&size, data + pos, sizeof(size));
+        pos += sizeof(size);
+
+        sid = instance::intern(std::string(data + pos, size));
+        pos += size;
+
+        line.push_back(static_cast<char>(record::tag::sid));
+        line.append(reinterpret_cast<const char *>(&sid), sizeof(sid));
+
+        return pos;
+    }
+
+    if (tag == record::tag::list) {
+        line.append(data + pos, 1 + sizeof(size));
+        pos++;
+        std::memcpy(&size, data + pos, sizeof(size));
+        pos += sizeof(size);
+
+        for (int i = 0; i < size && pos < len; i++) {
+            if (static_cast<record::tag>(data[pos]) == record::tag::trnc) {
+                break;
+            }
+            pos = instance::field(data, pos, len, line);
+        }
+
+        return pos;
+    }
+
+    if (tag == record::tag::str) {
+        std::memcpy(&size, data + pos + 1, sizeof(size));
+        size += sizeof(size);
+    } else if (tag == record::tag::byte) {
+        size = sizeof(std::uint8_t);
+    } else if (tag == record::tag::bin) {
+        size = sizeof(bool);
+    } else if (tag == record::tag::num) {
+        size = sizeof(int);
+    } else if (tag == record::tag::flt) {
+        size = sizeof(double);
+    } else if (tag == record::tag::ivec) {
+        std::memcpy(&size, data + pos + 1, sizeof(size));
+        size = sizeof(size) + size * sizeof(int);
+    } else if (tag == record::tag::fvec) {
+        std::memcpy(&size, data + pos + 1, sizeof(size));
+        size = sizeof(size) + size * sizeof(double);
+    } else if (tag == record::tag::imat) {
+        std::memcpy(&rows, data + pos + 1, sizeof(rows));
+        std::memcpy(&cols, data + pos + 1 + sizeof(rows), sizeof(cols));
+        size = sizeof(rows) + sizeof(cols) + rows * cols * sizeof(int);
+    } else if (tag == record::tag::fmat) {
+        std::memcpy(&rows, data + pos + 1, sizeof(rows));
+        std::memcpy(&cols, data + pos + 1 + sizeof(rows), sizeof(cols));
+        size = sizeof(rows) + sizeof(cols) + rows * cols * sizeof(double);
+    } else {
+        line.push_back(static_cast<char>(record::tag::trnc));
+        return len;
+    }
+
+    line.append(data + pos, 1 + size);
+
+    return pos + 1 + size;
+}
+
+std::uint32_t instance::intern (const std::string & str) {
+    std::uint32_t sid;
+    std::string defn;
+
+    auto itr = instance::strs.find(str);
+    if (itr != instance::strs.end()) {
+        return itr->second;
+    }
+
+    sid = instance::strs.size();
+    instance::strs[str] = sid;
+
+    defn.append(reinterpret_cast<const char *>(&sid), sizeof(sid));
+    defn.append(str);
+    instance::entry(record::kind::defn, defn);
+
+    return sid;
+}
+
+void instance::entry (record::kind kind, const std::string & data) {
+    int size = data.size();
+
+    instance::bin.push_back(static_cast<char>(kind));
+    instance::bin.append(reinterpret_cast<const char *>(&size), sizeof(size));
+    instance::bin.append(data);
+}
+
+void instance::prepare (void) {
+    instance::mutx.lock();
+    if (instance::init) {
+        instance::flush();
+    }
+}
+
+void instance::parent (void) {
+    instance::mutx.unlock();
+}
+
+void instance::child (void) {
+    instance::mutx.unlock();
+    if (instance::init) {
+        instance::strs.clear();
+        instance::fresh = true;
+
+        for (auto & elem : instance::sites) {
+            elem.supp.store(0, std::memory_order_relaxed);
+        }
+
+        if (instance::layout == mode::split) {
+            instance::detach();
+            if (!instance::attach()) {
+                instance::init = false;
+                return;
+            }
+        }
+
+        try {
+            instance::thrd = new std::thread(instance::drain);
+        } catch (...) {
+            instance::init = false;
+            instance::detach();
+        }
+    }
+}
+
+bool instance::attach (void) {
+    std::string name = instance::path;
+    std::size_t dir, ext;
+
+    if (instance::layout == mode::split) {
+        dir = name.rfind('/');
+        ext = name.rfind('.');
+        if (ext == std::string::npos || (dir != std::string::npos && ext < dir)) {
+            ext = name.size();
+        }
+        name.insert(ext, "." + instance::app + "." + std::to_string(getpid()));
+    }
+
+    instance::file.clear();
+    instance::file.open(name, std::ios::app | std::ios::binary);
+    if (instance::file.fail()) {
+        return false;
+    }
+
+    if (instance::layout == mode::shared) {
+        instance::desc = open(name.c_str(), O_RDONLY);
+        if (instance::desc < 0) {
+            instance::file.close();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void instance::detach (void) {
     instance::file.close();
-    close(instance::desc);
+    if (instance::layout == mode::shared) {
+        close(instance::desc);
+    }
+}
 
-    instance::init = false;
+void instance::body (record & rec) {
+    static_cast<void>(rec);
+}
+
+record::record (char * data, std::size_t cap) : data(data), cap(cap - 1), len(0), trnc(false) {}
+
+void record::put (const char * val) {
+    int size = std::strlen(val);
+
+    if (!this->room(1 + sizeof(size) + size)) {
+        return;
+    }
+
+    this->mark(tag::chr);
+    this->raw(&size, sizeof(size));
+    this->raw(val, size);
 }
 
-instance::instance (const std::string & lib) : lib(lib) {}
+void record::put (const std::string & val) {
+    int size = val.size();
 
-void instance::head (const std::string & lev) {
-    auto tstamp = std::chrono::steady_clock::now().time_since_epoch();
-    auto hour = std::chrono::duration_cast<std::chrono::hours>(tstamp);
-    auto min = std::chrono::duration_cast<std::chrono::minutes>(tstamp);
-    auto sec = std::chrono::duration_cast<std::chrono::seconds>(tstamp);
-    auto msec = std::chrono::duration_cast<std::chrono::milliseconds>(tstamp);
-    auto usec = std::chrono::duration_cast<std::chrono::microseconds>(tstamp);
+    if (!this->room(1 + sizeof(size) + size)) {
+        return;
+    }
+
+    this->mark(tag::str);
+    this->raw(&size, sizeof(size));
+    this->raw(val.data(), size);
+}
+
+void record::put (std::uint8_t val) {
+    if (!this->room(1 + sizeof(val))) {
+        return;
+    }
+
+    this->mark(tag::byte);
+    this->raw(&val, sizeof(val));
+}
+
+void record::put (bool val) {
+    if (!this->room(1 + sizeof(val))) {
+        return;
+    }
+
+    this->mark(tag::bin);
+    this->raw(&val, sizeof(val));
+}
+
+void record::put (int val) {
+    if (!this->room(1 + sizeof(val))) {
+        return;
+    }
+
+    this->mark(tag::num);
+    this->raw(&val, sizeof(val));
+}
+
+void record::put (double val) {
+    if (!this->room(1 + sizeof(val))) {
+        return;
+    }
+
+    this->mark(tag::flt);
+    this->raw(&val, sizeof(val));
+}
+
+void record::put (const linalg::ivector & val) {
+    int size = linalg::dim(val);
+
+    if (!this->room(1 + sizeof(size) + size * sizeof(int))) {
+        return;
+    }
+
+    this->mark(tag::ivec);
+    this->raw(&size, sizeof(size));
+    for (int i = 0; i < size; i++) {
+        this->raw(&val[i], sizeof(int));
+    }
+}
+
+void record::put (const linalg::fvector & val) {
+    int size = linalg::dim(val);
+
+    if (!this->room(1 + sizeof(size) + size * sizeof(double))) {
+        return;
+    }
 
-    usec -= msec;
-    msec -= sec;
-    sec -= min;
-    min -= hour;
+    this->mark(tag::fvec);
+    this->raw(&size, sizeof(size));
+    for (int i = 0; i < size; i++) {
+        this->raw(&val[i], sizeof(double));
+    }
+}
+
+void record::put (const linalg::imatrix & val) {
+    int rows = linalg::rows(val), cols = linalg::cols(val);
+
+    if (!this->room(1 + sizeof(rows) + sizeof(cols) + rows * cols * sizeof(int))) {
+        return;
+    }
+
+    this->mark(tag::imat);
+    this->raw(&rows, sizeof(rows));
+    this->raw(&cols, sizeof(cols));
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) {
+            this->raw(&val[i][j], sizeof(int));
+        }
+    }
+}
+
+void record::put (const linalg::fmatrix & val) {
+    int rows = linalg::rows(val), cols = linalg::cols(val);
+
+    if (!this->room(1 + sizeof(rows) + sizeof(cols) + rows * cols * sizeof(double))) {
+        return;
+    }
+
+    this->mark(tag::fmat);
+    this->raw(&rows, sizeof(rows));
+    this->raw(&cols, sizeof(cols));
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) {
+            this->raw(&val[i][j], sizeof(double));
+        }
+    }
+}
 
-    auto fill = instance::file.fill();
-    auto width = instance::file.width();
+void record::put_head (std::int64_t time, std::uint64_t site, std::uint8_t lev, const std::string & lib) {
+    int size = lib.size();
 
-    instance::file << "["
-                   << std::setfill('0') << std::setw(2) << hour.count()
-                   << ":"
-                   << std::setfill('0') << std::setw(2) << min.count()
-                   << ":"
-                   << std::setfill('0') << std::setw(2) << sec.count()
-                   << "."
-                   << std::setfill('0') << std::setw(3) << msec.count()
-                   << ","
-                   << std::setfill('0') << std::setw(3) << usec.count()
-                   << "] "
-                   << "<" << lev << "> " << instance::app << "/" << this->lib << ": ";
+    if (!this->room(sizeof(time) + sizeof(site) + sizeof(lev) + sizeof(size) + size)) {
+        return;
+    }
+
+    this->raw(&time, sizeof(time));
+    this->raw(&site, sizeof(site));
+    this->raw(&lev, sizeof(lev));
+    this->raw(&size, sizeof(size));
+    this->raw(lib.data(), size);
+}
+
+std::size_t record::seal (void) {
+    if (this->trnc) {
+        this->data[this->len] = static_cast<char>(tag::trnc);
+        this->len++;
+        this->trnc = false;
+    }
+
+    return this->len;
+}
+
+bool record::room (std::size_t size) {
+    if (this->trnc) {
+        return false;
+    }
+
+    if (this->len + size > this->cap) {
+        this->trnc = true;
+        return false;
+    }
+
+    return true;
+}
 
-    instance::file.fill(fill);
-    instance::file.width(width);
+void record::raw (const void * src, std::size_t size) {
+    std::memcpy(this->data + this->len, src, size);
+    this->len += size;
 }
 
-void instance::body (void) {
-    instance::file << std::endl;
+void record::mark (tag tag) {
+    this->data[this->len] = static_cast<char>(tag);
+    this->len++;
 }
 
-stream::stream (std::ofstream & file) : file(&file) {}
+stream::stream (std::ostream & file) : file(&file) {}
 
 stream & stream::operator << (const char * val) {
     *(this->file) << val;
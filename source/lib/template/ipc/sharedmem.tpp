@@ -0,0 +1,196 @@
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+
+#include <new>
+#include <string>
+#include <type_traits>
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+namespace sharedmem {
+
+template <typename type>
+vecview<type>::vecview (type * data, int dim) : data(data), len(dim) {}
+
+template <typename type>
+type & vecview<type>::operator [] (int idx) const {
+    return this->data[idx];
+}
+
+template <typename type>
+int vecview<type>::dim (void) const {
+    return this->len;
+}
+
+template <typename type>
+matview<type>::matview (type * data, int rows, int cols) : data(data), nrow(rows), ncol(cols) {}
+
+template <typename type>
+type * matview<type>::operator [] (int idx) const {
+    return this->data + idx * this->ncol;
+}
+
+template <typename type>
+int matview<type>::rows (void) const {
+    return this->nrow;
+}
+
+template <typename type>
+int matview<type>::cols (void) const {
+    return this->ncol;
+}
+
+
+template <typename type>
+instance<type>::instance (const std::string & name, mode mode)
+  : logging("sharedmem"), init(false), id(instance<type>::instantiate()), name(name), len(sizeof(type)),
+    create(mode == mode::create || mode == mode::both), remove(mode == mode::remove || mode == mode::both) {
+
+    bool obj_open = false, obj_map = false;
+    int ret, desc;
+    void * addr;
+
+    this->logging.inf("Initializing instance #", this->id, ": Type: ", instance<type>::type_name(), ", Size: ", int(this->len), ", Name: ", this->name);
+
+    try {
+        this->logging.inf("Opening shared memory object #", this->id);
+        if (this->create) {
+            desc = shm_open(this->name.c_str(), O_RDWR | O_CREAT, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH);
+        } else {
+            desc = shm_open(this->name.c_str(), O_RDWR, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH);
+        }
+        if (desc < 0) {
+            this->logging.err("Failed to open shared memory object #", this->id, " (", std::strerror(errno), ")");
+            throw except_intern{};
+        }
+
+        obj_open = true;
+
+        this->logging.inf("Resizing shared memory object #", this->id);
+        ret = ftruncate(desc, this->len);
+        if (ret < 0) {
+            this->logging.err("Failed to resize shared memory object #", this->id, " (", std::strerror(errno), ")");
+            throw except_intern{};
+        }
+
+        this->logging.inf("Mapping shared memory region #", this->id);
+        addr = mmap(NULL, this->len, PROT_READ | PROT_WRITE, MAP_SHARED, desc, 0);
+        if (addr == MAP_FAILED) {
+            this->logging.err("Failed to map shared memory region #", this->id, " (", std::strerror(errno), ")");
+            throw except_intern{};
+        }
+
+        obj_map = true;
+
+        this->data = std::launder(static_cast<type *>(addr));
+
+        obj_open = false;
+
+        this->logging.inf("Closing shared memory object #", this->id);
+        ret = close(desc);
+        if (ret < 0) {
+            this->logging.err("Failed to close shared memory object #", this->id, " (", std::strerror(errno), ")");
+            throw except_intern{};
+        }
+    } catch (except_intern) {
+        if (obj_open) {
+            this->logging.wrn("Closing shared memory object #", this->id);
+            ret = close(desc);
+            if (ret < 0) {
+                this->logging.err("Failed to close shared memory object #", this->id, " (", std::strerror(errno), ")");
+            }
+        }
+
+        if (obj_map) {
+            this->logging.wrn("Unmapping shared memory region #", this->id);
+            ret = munmap(addr, this->len);
+            if (ret < 0) {
+                this->logging.err("Failed to unmap shared memory region #", this->id, " (", std::strerror(errno), ")");
+            }
+        }
+
+        this->logging.err("Failed to initialize instance #", this->id);
+        throw except_ctor::fail;
+    }
+
+    this->init = true;
+}
+
+template <typename type>
+instance<type>::~instance (void) {
+    int ret;
+
+    if (this->init) {
+        this->logging.inf("Unmapping shared memory region #", this->id);
+        ret = munmap(this->data, this->len);
+        if (ret < 0) {
+            this->logging.err("Failed to unmap shared memory region #", this->id, " (", std::strerror(errno), ")");
+        }
+
+        if (this->remove) {
+            this->logging.inf("Unlinking shared memory object #", this->id);
+            ret = shm_unlink(this->name.c_str());
+            if (ret < 0) {
+                this->logging.err("Failed to unlink shared memory object #", this->id, " (", std::strerror(errno), ")");
+            }
+        }
+    }
+}
+
+template <typename type>
+void instance<type>::put (const type & val) {
+    if constexpr (instance<type>::scalar) {
+        this->logging.inf("Writing data to shared memory region #", this->id, ": Type: ", instance<type>::type_name(), ", Value: ", val);
+    } else {
+        this->logging.inf("Writing data to shared memory region #", this->id, ": Type: ", instance<type>::type_name());
+    }
+
+    if (!this->init) {
+        this->logging.err("Failed to write data to shared memory region #", this->id, " (Instance not initialized)");
+        throw except_put::fail;
+    }
+
+    std::memcpy(this->data, &val, sizeof(type));
+}
+
+template <typename type>
+type instance<type>::get (void) {
+    type val;
+
+    this->logging.inf("Reading data from shared memory region #", this->id, ": Type: ", instance<type>::type_name());
+
+    if (!this->init) {
+        this->logging.err("Failed to read data from shared memory region #", this->id, " (Instance not initialized)");
+        throw except_get::fail;
+    }
+
+    std::memcpy(&val, this->data, sizeof(type));
+
+    if constexpr (instance<type>::scalar) {
+        this->logging.inf("Read data from shared memory region #", this->id, ": Value: ", val);
+    }
+
+    return val;
+}
+
+template <typename type>
+const char * instance<type>::type_name (void) {
+    if constexpr (std::is_same_v<type, std::uint8_t>) {
+        return "Byte";
+    } else if constexpr (std::is_same_v<type, bool>) {
+        return "Boolean";
+    } else if constexpr (std::is_same_v<type, int>) {
+        return "Integer scalar";
+    } else if constexpr (std::is_same_v<type, double>) {
+        return "Real scalar";
+    } else {
+        return "Record";
+    }
+}
+
+}
@@ -1,47 +1,94 @@
+#include <chrono>
+#include <cstdint>
+#include <sstream>
 #include <string>
-
-#include <sys/file.h>
+#include <vector>
 
 namespace logging {
 
 template <typename ... types>
-void instance::inf (const types & ... args) {
-    this->msg("inf", args ...);
+void instance::inf (const origin & orig, const types & ... args) {
+    if constexpr (instance::base <= level::inf) {
+        if (this->thrs->load(std::memory_order_relaxed) <= level::inf) {
+            this->msg(level::inf, orig, args ...);
+        }
+    }
 }
 
 template <typename ... types>
-void instance::wrn (const types & ... args) {
-    this->msg("wrn", args ...);
+void instance::wrn (const origin & orig, const types & ... args) {
+    if constexpr (instance::base <= level::wrn) {
+        if (this->thrs->load(std::memory_order_relaxed) <= level::wrn) {
+            this->msg(level::wrn, orig, args ...);
+        }
+    }
 }
 
 template <typename ... types>
-void instance::err (const types & ... args) {
-    this->msg("err", args ...);
+void instance::err (const origin & orig, const types & ... args) {
+    if constexpr (instance::base <= level::err) {
+        if (this->thrs->load(std::memory_order_relaxed) <= level::err) {
+            this->msg(level::err, orig, args ...);
+        }
+    }
 }
 
 template <typename type, typename ... types>
-void instance::body (const type & arg, const types & ... args) {
-    instance::strm << arg;
-    this->body(args ...);
+void instance::body (record & rec, const type & arg, const types & ... args) {
+    rec.put(arg);
+    this->body(rec, args ...);
 }
 
 template <typename ... types>
-void instance::msg (const std::string & lev, const types & ... args) {
-    int ret;
+void instance::msg (level lev, const origin & orig, const types & ... args) {
+    std::int64_t time = std::chrono::steady_clock::now().time_since_epoch().count();
+    cell * cell;
 
     if (!instance::init) {
         return;
     }
 
-    ret = flock(instance::desc, LOCK_EX);
-    if (ret < 0) {
+    if (lev == level::inf && !this->admit(orig.key, time, orig.text)) {
+        return;
+    }
+
+    cell = instance::claim();
+    if (cell == nullptr) {
         return;
     }
 
-    this->head(lev);
-    this->body(args ...);
+    record rec(cell->data, instance::cell_size);
+
+    rec.put_head(time, orig.key, static_cast<std::uint8_t>(lev), this->lib);
+    rec.put(orig.text);
+    this->body(rec, args ...);
+
+    instance::commit(cell, rec.seal());
+}
+
+template <typename type>
+void record::put (const std::vector<type> & val) {
+    int count = val.size();
+
+    if (!this->room(1 + sizeof(count))) {
+        return;
+    }
+
+    this->mark(tag::list);
+    this->raw(&count, sizeof(count));
+
+    for (const auto & elem : val) {
+        this->put(elem);
+    }
+}
+
+template <typename type, typename>
+void record::put (const type & val) {
+    std::ostringstream text;
+    stream strm(text);
 
-    flock(instance::desc, LOCK_UN);
+    strm << val;
+    this->put(text.str().c_str());
 }
 
 }